@@ -28,8 +28,12 @@ extern "C"
 #include <rcutils/logging_macros.h>
 
 #include "rclc/executor_handle.h"
+#include "rclc/executor_trace.h"
 #include "rclc/types.h"
 #include "rclc/sleep.h"
+#include "rclc/synchronizer.h"
+#include "rclc/timer_wheel.h"
+#include "rclc/trigger_expression.h"
 #include "rclc/visibility_control.h"
 
 #include "rclc/action_client.h"
@@ -40,7 +44,10 @@ extern "C"
     processed in a user-defined order.
 */
 
-/** Defines the semantics when data is taken from DDS
+/// Timeout for rclc_executor_spin_some(), with which rcl_wait() blocks until a handle is ready
+#define RCLC_EXECUTOR_WAIT_FOREVER UINT64_MAX
+
+/** Defines the semantics when data is taken from DDS and in which order callbacks are executed
  *  SEMANTICS_RCLCPP_EXECUTOR        - same semantics as in rclcpp Executor. Data of a subscription
  *                                     is taken from DDS just before the corresponding callback
  *                                     is called by the Executor.
@@ -51,11 +58,19 @@ extern "C"
  *                                     between the sampling point t and the time point at which
  *                                     the callback is called, it would not be considered in this
  *                                     `rclc_executor_spin_some` iteration.
+ *  SEMANTICS_EARLIEST_DEADLINE_FIRST - data is taken like in SEMANTICS_RCLCPP_EXECUTOR, but the
+ *                                     ready callbacks are executed in the order of their
+ *                                     absolute deadline (release time plus relative deadline of
+ *                                     the handle). The release time of a timer is its scheduled
+ *                                     call time, of all other handles the time at which the
+ *                                     executor detected new data. Handles without deadline are
+ *                                     executed last.
 */
 typedef enum
 {
   RCLC_SEMANTICS_RCLCPP_EXECUTOR,
-  RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME
+  RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME,
+  RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST
 } rclc_executor_semantics_t;
 
 /**
@@ -69,12 +84,124 @@ typedef enum
   RCLC_EXECUTOR_NON_POSIX,
 } rclc_executor_type_t;
 
+/**
+ * Distribution of ready handles to the worker threads of a multi-threaded Executor.
+ *  RCLC_WORKER_SCHEDULING_WORK_STEALING - every worker thread has its own deque. Ready handles
+ *                                         are distributed round-robin to the deques and idle
+ *                                         worker threads steal from the deques of others.
+ *  RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE  - all worker threads share one first-in first-out queue.
+*/
+typedef enum
+{
+  RCLC_WORKER_SCHEDULING_WORK_STEALING,
+  RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE
+} rclc_executor_worker_scheduling_t;
+
+/**
+ * Behavior of rclc_executor_spin_one_period, if a spin takes longer than the period (overrun).
+ *  RCLC_PERIOD_OVERRUN_CATCH_UP - the following spins start immediately, until the executor
+ *                                 is back on the original schedule, i.e. no period is lost.
+ *  RCLC_PERIOD_OVERRUN_SKIP     - the missed periods are skipped and the next spin starts at
+ *                                 the next time point of the original schedule.
+*/
+typedef enum
+{
+  RCLC_PERIOD_OVERRUN_CATCH_UP,
+  RCLC_PERIOD_OVERRUN_SKIP
+} rclc_executor_period_overrun_policy_t;
+
 /// Type definition for trigger function. With the parameters:
 /// - array of executor_handles
 /// - size of array
 /// - application specific struct used in the trigger function
 typedef bool (* rclc_executor_trigger_t)(rclc_executor_handle_t *, unsigned int, void *);
 
+/// Container for the rcl-handles, which are added to the wait_set in every spin.
+/// The rcl-handles are sorted by type (subscriptions, timers, clients, services and
+/// guard conditions, followed by the executor handles of action clients and action servers).
+/// It is updated in {@link rclc_executor_prepare()} only if handles have been added or removed.
+typedef struct
+{
+  /// Dynamic array of size max_handles
+  const void ** entities;
+  /// Number of subscriptions in array entities
+  size_t number_of_subscriptions;
+  /// Number of timers in array entities
+  size_t number_of_timers;
+  /// Number of clients in array entities
+  size_t number_of_clients;
+  /// Number of services in array entities
+  size_t number_of_services;
+  /// Number of guard conditions in array entities
+  size_t number_of_guard_conditions;
+  /// Number of action clients and action servers in array entities
+  size_t number_of_actions;
+} rclc_executor_wait_set_entities_t;
+
+/// Runtime statistics of the spins of an executor, which are recorded if statistics are enabled
+/// (see rclc_executor_enable_statistics).
+typedef struct
+{
+  /// Number of spins
+  uint64_t spins;
+  /// Total time spent in rcl_wait in nanoseconds
+  uint64_t wait_time_total_ns;
+  /// Maximum time spent in rcl_wait in one spin in nanoseconds
+  uint64_t wait_time_max_ns;
+  /// Total time spent in taking data and dispatching callbacks in nanoseconds
+  uint64_t dispatch_time_total_ns;
+  /// Maximum time spent in taking data and dispatching callbacks in one spin in nanoseconds
+  uint64_t dispatch_time_max_ns;
+} rclc_executor_spin_statistics_t;
+
+/// Statistics of rclc_executor_spin_one_period. The jitter of a period is the delay of the
+/// start of the spin after its scheduled time point.
+typedef struct
+{
+  /// Number of periods
+  uint64_t periods;
+  /// Number of spins, which took longer than the period
+  uint64_t overruns;
+  /// Number of periods, which were skipped (policy RCLC_PERIOD_OVERRUN_SKIP)
+  uint64_t skipped_periods;
+  /// Jitter of the last period in nanoseconds
+  int64_t jitter_last_ns;
+  /// Minimum jitter in nanoseconds
+  int64_t jitter_min_ns;
+  /// Maximum jitter in nanoseconds
+  int64_t jitter_max_ns;
+  /// Sum of the jitter of all periods in nanoseconds (mean = jitter_total_ns / periods)
+  int64_t jitter_total_ns;
+} rclc_executor_period_statistics_t;
+
+/// Statistics of the busy polling of rcl_wait (see rclc_executor_set_busy_poll).
+typedef struct
+{
+  /// Number of calls of rcl_wait with zero timeout
+  uint64_t polls;
+  /// Number of spins, in which new data was found by busy polling
+  uint64_t busy_poll_hits;
+  /// Number of spins, which fell back to a blocking rcl_wait after the busy-poll window
+  uint64_t blocking_waits;
+  /// Number of blocking waits, which returned with new data (and not with a timeout)
+  uint64_t blocking_wakeups;
+} rclc_executor_busy_poll_statistics_t;
+
+/// Statistics of the dispatch budget (see rclc_executor_set_dispatch_budget).
+typedef struct
+{
+  /// Number of spins, in which the dispatch budget was used up before all ready handles
+  /// were executed
+  uint64_t exhausted_spins;
+  /// Total number of ready handles, which were deferred to the next spin
+  uint64_t deferred_handles;
+  /// Number of handles, which were deferred in the last spin
+  size_t deferred_handles_last;
+} rclc_executor_budget_statistics_t;
+
+/// Pool of worker threads of a multi-threaded executor (opaque).
+struct rclc_executor_worker_pool_s;
+
 /// function pointer specification
 typedef struct rclc_executor_t_s rclc_executor_t;
 typedef rcl_ret_t (* rclc_executor_func_t)(rclc_executor_t *);
@@ -96,12 +223,75 @@ struct rclc_executor_t_s
   const rcl_allocator_t * allocator;
   /// Wait set (is initialized only in the first call of the rclc_executor_spin_some function)
   rcl_wait_set_t wait_set;
+  /// rcl-handles sorted by type, which are added to the wait_set in every spin
+  rclc_executor_wait_set_entities_t wait_set_entities;
+  /// Flag, which is false, if the wait_set_entities have to be computed again
+  bool wait_set_entities_is_valid;
+  /// Hash table (open addressing) with the indices of the handles in the array handles,
+  /// the key is the pointer to the rcl-handle (see rclc_executor_handle_get_ptr)
+  size_t * handle_map;
+  /// Size of handle_map minus one (the size is a power of two)
+  size_t handle_map_mask;
+  /// Registration number of the next handle, which is added to the executor
+  size_t next_registration_number;
+  /// Dynamic array of size max_handles with the indices of the handles in the order in
+  /// which they are processed (registration order or sorted by priority)
+  size_t * dispatch_order;
+  /// Flag, which is false, if the dispatch_order has to be computed again
+  bool dispatch_order_is_valid;
+  /// Dynamic array of size max_handles with the hot data of the handles in dispatch_order
+  rclc_executor_handle_hot_t * hot_handles;
+  /// Flag, which is true, if ready handles are processed highest priority first
+  bool priority_scheduling;
+  /// Dynamic array of size max_handles with the indices of the ready handles of the current spin
+  size_t * ready_list;
+  /// Number of handles in ready_list
+  size_t ready_list_size;
+  /// Bitmap with one bit per entry of handles, which is set if the handle has new data in the
+  /// current spin. It is updated before the trigger condition is evaluated.
+  uint64_t * ready_bitmap;
+  /// Number of 64-bit words of ready_bitmap
+  size_t ready_bitmap_words;
+  /// Array of size max_handles (in the memory of ready_list) with the indices of the handles,
+  /// which are deferred to the next spin, because the dispatch budget was used up
+  size_t * deferred_list;
+  /// Number of handles in deferred_list
+  size_t deferred_list_size;
+  /// Number of deferred handles at the beginning of ready_list in the current spin
+  size_t carried_over_size;
+  /// Flag, which is true, if the handles in deferred_list can be executed in the next spin
+  /// without new data, i.e. the trigger condition was fulfilled when they were deferred
+  bool deferred_runnable;
+  /// Time budget in nanoseconds for executing the callbacks of one spin, 0 if unlimited
+  uint64_t dispatch_budget_ns;
+  /// time of rclc_monotonic_time_ns, at which dispatching of the current spin started
+  int64_t dispatch_start_ns;
+  /// statistics of the dispatch budget
+  rclc_executor_budget_statistics_t budget_statistics;
+  /// Total number of deadline misses (earliest-deadline-first semantics)
+  size_t deadline_misses;
+  /// Monitoring configuration, which is shared by all handles
+  rclc_executor_monitoring_t monitoring;
+  /// Runtime statistics of the spins (only recorded if monitoring.statistics_enabled is true)
+  rclc_executor_spin_statistics_t spin_statistics;
   /// Statistics objects about total number of subscriptions, timers, clients, services, etc.
   rclc_executor_handle_counters_t info;
   /// timeout in nanoseconds for rcl_wait() used in rclc_executor_spin_once(). Default 100ms
   uint64_t timeout_ns;
-  /// timepoint used for spin_period()
+  /// Flag, which is true, if rclc_executor_spin() derives the timeout from the next timer
+  bool tickless_wait;
+  /// upper bound of the timeout of rclc_executor_spin() in tickless mode, 0 if unbounded
+  uint64_t tickless_max_timeout_ns;
+  /// timepoint used for spin_period() (time of rclc_monotonic_time_ns)
   rcutils_time_point_value_t invocation_time;
+  /// behavior of spin_period(), if a spin takes longer than the period
+  rclc_executor_period_overrun_policy_t period_overrun_policy;
+  /// statistics of spin_period()
+  rclc_executor_period_statistics_t period_statistics;
+  /// duration in nanoseconds, in which rcl_wait is polled with zero timeout, 0 if disabled
+  uint64_t busy_poll_ns;
+  /// statistics of the busy polling
+  rclc_executor_busy_poll_statistics_t busy_poll_statistics;
   /// trigger function, when to process new data
   rclc_executor_trigger_t trigger_function;
   /// application specific data structure for trigger function
@@ -110,6 +300,14 @@ struct rclc_executor_t_s
   rclc_executor_semantics_t data_comm_semantics;
   /// pointer to custom executor data structure
   void * custom;
+  /// worker threads, only for type RCLC_EXECUTOR_MULTI_THREADED
+  struct rclc_executor_worker_pool_s * worker_pool;
+  /// timer wheel of the wheel timers, NULL if it is not enabled
+  struct rclc_executor_timer_wheel_s * timer_wheel;
+  /// distribution of ready handles to the worker threads
+  rclc_executor_worker_scheduling_t worker_scheduling;
+  /// guard condition, which wakes up rcl_wait when a worker thread has finished a callback
+  rcl_guard_condition_t worker_guard_condition;
 };
 
 /**
@@ -149,7 +347,964 @@ rclc_executor_get_zero_initialized_executor(void);
  * updated and rclc_executor_prepare is called again (with dynamic memory allocation in RCL).
  *
  *
- *  * <hr>
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor preallocated rclc_executor_t
+ * \param[in] context RCL context
+ * \param[in] number_of_handles is the total number of subscriptions, timers, services,
+ *  clients and guard conditions. Do not include the number of nodes and publishers.
+ * \param[in] allocator allocator for allocating memory
+ * \return `RCL_RET_OK` if the executor was initialized successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any null pointer as argument
+ * \return `RCL_RET_ERROR` in case of failure
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_init(
+  rclc_executor_t * executor,
+  rcl_context_t * context,
+  const size_t number_of_handles,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Set timeout in nanoseconds for rcl_wait (called during {@link rclc_executor_spin_once()}).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] timeout_ns  timeout in nanoseconds for the rcl_wait (DDS middleware)
+ * \return `RCL_RET_OK` if timeout was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` in an error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_timeout(
+  rclc_executor_t * executor,
+  const uint64_t timeout_ns);
+
+/**
+ *  Enables or disables the tickless wait of {@link rclc_executor_spin()}. If enabled, the
+ *  timeout of rcl_wait is not {@link rclc_executor_t.timeout_ns}, but \p max_timeout_ns or
+ *  no timeout, if \p max_timeout_ns is 0. rcl_wait limits the timeout to the time until the
+ *  next call of the earliest active timer in the wait_set, so that an idle executor sleeps
+ *  until the next timer is due or new data arrives, without a periodic wake-up. The bound
+ *  \p max_timeout_ns can be used e.g. to check regularly whether the context is still valid.
+ *  If it is 0 and the executor has no active timer, rcl_wait blocks until a handle is ready.
+ *
+ *  The tickless wait is disabled by default.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] enable true to enable, false to disable the tickless wait
+ * \param [in] max_timeout_ns upper bound of the timeout in nanoseconds, 0 for no bound
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` if the executor is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_tickless_wait(
+  rclc_executor_t * executor,
+  bool enable,
+  const uint64_t max_timeout_ns);
+
+/**
+ *  Returns the timeout, which {@link rclc_executor_spin()} passes to
+ *  {@link rclc_executor_spin_some()}: the maximum timeout of
+ *  {@link rclc_executor_set_tickless_wait()} or RCLC_EXECUTOR_WAIT_FOREVER, if there is no
+ *  maximum timeout. The timers are not scanned, because rcl_wait limits the timeout to the
+ *  next timer in the wait_set, so the cost per spin does not depend on the number of timers.
+ *  If the tickless wait is disabled, \p timeout_ns is {@link rclc_executor_t.timeout_ns}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to an initialized executor
+ * \param [out] timeout_ns timeout in nanoseconds
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_wait_timeout(
+  const rclc_executor_t * executor,
+  uint64_t * timeout_ns);
+
+/**
+ *  Enables the hybrid busy polling of {@link rclc_executor_spin_some()} (and therefore also of
+ *  {@link rclc_executor_spin()}). rcl_wait is first called with zero timeout until a handle is
+ *  ready or the busy-poll window \p busy_poll_ns has elapsed, then the executor falls back to
+ *  a blocking rcl_wait for the remaining timeout. This avoids the wake-up latency of a
+ *  blocking wait for data, which arrives within the window, at the cost of one busy CPU
+ *  core during the window. The window is bounded by the timeout of the spin.
+ *
+ *  How often data was found by polling and how often the blocking wait was used is
+ *  reported by {@link rclc_executor_get_busy_poll_statistics()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] busy_poll_ns busy-poll window in nanoseconds, 0 disables busy polling
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p busy_poll_ns is
+ *   larger than INT64_MAX
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_busy_poll(
+  rclc_executor_t * executor,
+  const uint64_t busy_poll_ns);
+
+/**
+ *  Copies the statistics of the busy polling into \p statistics: the number of polls with
+ *  zero timeout, of spins in which data was found by polling, of fall-backs to the blocking
+ *  wait and of blocking waits, which returned with new data.
+ *  The statistics are reset with {@link rclc_executor_reset_statistics()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to an initialized executor
+ * \param [out] statistics statistics of the busy polling
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_busy_poll_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_busy_poll_statistics_t * statistics);
+
+/**
+ *  Sets the time budget for executing the callbacks in one spin of
+ *  {@link rclc_executor_spin_some()} (and therefore of {@link rclc_executor_spin()} and
+ *  {@link rclc_executor_spin_one_period()}). The budget is checked before each ready handle
+ *  is executed, at least one handle is executed per spin. If the budget is used up, the
+ *  remaining ready handles are not executed, but deferred to the next spin, in which they
+ *  are executed before all other ready handles:
+ *  * RCLCPP and earliest-deadline-first semantics: the data of a deferred handle has not been
+ *    taken yet and is taken in the next spin.
+ *  * LET semantics: the data of a deferred handle has already been taken at the sampling
+ *    point; the callback is called with this data in the next spin and no new data is taken
+ *    for the handle in that spin.
+ *
+ *  Deferred handles count as ready for the trigger condition. The next spin does not wait in
+ *  rcl_wait, unless the trigger condition is not fulfilled, then the deferred handles wait
+ *  for the trigger like all other handles. They are discarded, if handles
+ *  are added to or removed from the executor. The multi-threaded executor does not
+ *  support a budget (see {@link rclc_executor_set_worker_threads()}).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] budget_ns dispatch budget in nanoseconds, 0 for no budget (default)
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer or \p budget_ns is
+ *   larger than INT64_MAX
+ * \return `RCL_RET_ERROR` if \p budget_ns is not 0 and the worker threads of a
+ *   multi-threaded executor are running (see {@link rclc_executor_set_worker_threads()})
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_dispatch_budget(
+  rclc_executor_t * executor,
+  const uint64_t budget_ns);
+
+/**
+ *  Copies the statistics of the dispatch budget into \p statistics: the number of spins, in
+ *  which the budget was used up, and the number of deferred handles in total and in the
+ *  last spin. The statistics are reset with {@link rclc_executor_reset_statistics()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to an initialized executor
+ * \param [out] statistics statistics of the dispatch budget
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_budget_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_budget_statistics_t * statistics);
+
+/**
+ *  Set data communication semantics
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to an initialized executor
+ * \param [in] valid semantics value as defined in enum type {@link rclc_executor_semantics_t}
+ * \return `RCL_RET_OK` if semantics was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_ERROR` if the executor is not initialized or if the worker threads of a
+ *   multi-threaded executor are running and \p semantics is not
+ *   RCLC_SEMANTICS_RCLCPP_EXECUTOR (see {@link rclc_executor_set_worker_threads()})
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_semantics(
+  rclc_executor_t * executor,
+  rclc_executor_semantics_t semantics);
+
+/**
+ *  Configures the number of worker threads of the executor.
+ *  With \p number_of_threads greater than zero, the executor type is set to
+ *  RCLC_EXECUTOR_MULTI_THREADED: the thread calling the spin-functions owns rcl_wait and
+ *  takes new data from the DDS queue. The callbacks of ready handles are then dispatched
+ *  to a fixed-size pool of \p number_of_threads worker threads. A handle is not dispatched
+ *  again and not waited on, as long as its callback is executed by a worker thread, so the
+ *  callback of one handle is never executed concurrently. Callbacks of different handles
+ *  may run in parallel and must be thread-safe with respect to shared data.
+ *  Callbacks of action clients and action servers are executed in the spinning thread.
+ *
+ *  In multi-threaded mode, spin_some() returns after dispatching the callbacks without
+ *  waiting for their completion. Errors of callbacks are returned by the next call of
+ *  spin_some(). The take budget {@link rclc_executor_set_subscription_max_takes()} is
+ *  not applied; a subscription with further messages is dispatched again when its callback
+ *  has finished. rclc_executor_fini() and removing a handle wait for all running callbacks.
+ *  The ready handles are taken and dispatched with the semantics
+ *  RCLC_SEMANTICS_RCLCPP_EXECUTOR. The semantics RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME and
+ *  RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST (including the deadline tracking) and the dispatch
+ *  budget {@link rclc_executor_set_dispatch_budget()} are not supported: the worker threads
+ *  are not started, if one of them is configured, and they cannot be configured, while the
+ *  worker threads are running.
+ *
+ *  With \p number_of_threads equal to zero, the worker threads are stopped and the
+ *  executor type is set to RCLC_EXECUTOR_SINGLE_THREADED.
+ *
+ *  This function must not be called concurrently with a spin-function.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] number_of_threads number of worker threads, 0 for single-threaded execution
+ * \return `RCL_RET_OK` if the worker threads were configured successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ * \return `RCL_RET_UNSUPPORTED` if POSIX threads are not available on this platform
+ * \return `RCL_RET_ERROR` if the semantics is not RCLC_SEMANTICS_RCLCPP_EXECUTOR, if a
+ *   dispatch budget is set or if another error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_worker_threads(
+  rclc_executor_t * executor,
+  size_t number_of_threads);
+
+/**
+ *  Sets the distribution of ready handles to the worker threads of a multi-threaded
+ *  executor. The default is RCLC_WORKER_SCHEDULING_WORK_STEALING, which avoids the
+ *  contention of a single shared queue, if many short callbacks become ready at once.
+ *  The setting takes effect with the next call of {@link rclc_executor_set_worker_threads()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] scheduling distribution of ready handles to the worker threads
+ * \return `RCL_RET_OK` if scheduling was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ * \return `RCL_RET_ERROR` if executor is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_worker_scheduling(
+  rclc_executor_t * executor,
+  rclc_executor_worker_scheduling_t scheduling);
+
+/**
+ *  Enables or disables priority scheduling. If enabled, the ready handles are taken
+ *  and executed in the order of their {@link rclc_executor_handle_t.priority},
+ *  highest priority first. Handles with equal priority are processed in the order,
+ *  in which they were added to the executor. If disabled (default), all handles are
+ *  processed in the order, in which they were added.
+ *
+ *  The processing order is computed only once, when the set of handles or a priority has
+ *  changed, and not in every spin.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] enable true to process ready handles highest priority first
+ * \return `RCL_RET_OK` if priority scheduling was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ * \return `RCL_RET_ERROR` if executor is not initialized
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_priority_scheduling(
+  rclc_executor_t * executor,
+  bool enable);
+
+/**
+ *  Sets the priority of a handle, which is used if priority scheduling is enabled with
+ *  {@link rclc_executor_set_priority_scheduling()}. Higher values denote higher priority.
+ *  The default priority is 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] rcl_handle pointer to the rcl-handle (e.g. rcl_subscription_t, rcl_timer_t),
+ *   which was added to the executor
+ * \param [in] priority priority of the handle
+ * \return `RCL_RET_OK` if the priority was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the handle is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_handle_priority(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  int priority);
+
+/**
+ *  Sets the relative deadline of a handle, which is used by the semantics
+ *  RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST. The absolute deadline of a callback is its release
+ *  time plus \p deadline. If the callback finishes after its absolute deadline, the deadline
+ *  miss is counted in {@link rclc_executor_handle_t.deadline_misses} and
+ *  {@link rclc_executor_t.deadline_misses}. A \p deadline of 0 means no deadline. If a
+ *  subscription takes several messages per spin (see
+ *  {@link rclc_executor_set_subscription_max_takes()}), only the callback of the first
+ *  message is checked against the deadline.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] rcl_handle pointer to the rcl-handle (e.g. rcl_subscription_t, rcl_timer_t),
+ *   which was added to the executor
+ * \param [in] deadline relative deadline in nanoseconds, 0 for no deadline
+ * \return `RCL_RET_OK` if the deadline was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or deadline is negative
+ * \return `RCL_RET_ERROR` if the handle is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_handle_deadline(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  rcutils_duration_value_t deadline);
+
+/**
+ *  Sets the expected worst-case execution time (WCET) of the callback of a handle. Every
+ *  execution of the callback is timed with the steady clock. If it takes longer than
+ *  \p wcet_ns, the overrun is counted in {@link rclc_executor_handle_t.wcet_overruns}, the
+ *  longest overrunning duration is kept in {@link rclc_executor_handle_t.wcet_worst_ns} and the
+ *  overrun callback of the executor is called, if it is set (see
+ *  {@link rclc_executor_set_overrun_callback()}). The callback itself is not interrupted.
+ *  A \p wcet_ns of 0 disables the monitoring of the handle (default). Setting the WCET resets
+ *  the overrun counters of the handle. With the multi-threaded executor, it waits until the
+ *  worker threads have finished all running callbacks, so it must not be called from a
+ *  callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] rcl_handle pointer to the rcl-handle (e.g. rcl_subscription_t, rcl_timer_t),
+ *   which was added to the executor
+ * \param [in] wcet_ns worst-case execution time in nanoseconds, 0 to disable monitoring
+ * \return `RCL_RET_OK` if the WCET was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the handle is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_handle_wcet(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  uint64_t wcet_ns);
+
+/**
+ *  Sets the overrun callback, which is called after a callback took longer than the
+ *  worst-case execution time of its handle (see {@link rclc_executor_set_handle_wcet()}).
+ *  It is called with the rcl-handle, the measured duration, the WCET and \p context.
+ *  With the multi-threaded executor, it is called by the worker thread, which executed the
+ *  callback. A \p callback of NULL removes the overrun callback; overruns are still counted.
+ *  With the multi-threaded executor, it waits until the worker threads have finished all
+ *  running callbacks, so it must not be called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] callback overrun callback or NULL
+ * \param [in] context application specific context passed to the overrun callback
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_overrun_callback(
+  rclc_executor_t * executor,
+  rclc_executor_overrun_callback_t callback,
+  void * context);
+
+/**
+ *  Returns the number of WCET overruns of a handle and the longest measured duration of an
+ *  overrunning callback (see {@link rclc_executor_set_handle_wcet()}). With the
+ *  multi-threaded executor, it waits until the worker threads have finished all running
+ *  callbacks, which update the counters, so it must not be called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [in] executor pointer to initialized executor
+ * \param [in] rcl_handle pointer to the rcl-handle (e.g. rcl_subscription_t, rcl_timer_t),
+ *   which was added to the executor
+ * \param [out] overruns number of callback executions, which took longer than the WCET
+ * \param [out] worst_ns longest duration of an overrunning callback in nanoseconds, 0 if
+ *   there was no overrun
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the handle is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_handle_wcet_overruns(
+  const rclc_executor_t * executor,
+  const void * rcl_handle,
+  uint64_t * overruns,
+  uint64_t * worst_ns);
+
+/**
+ *  Enables or disables the recording of runtime statistics. Per handle, the number of callback
+ *  invocations, the number of failed takes and the minimum, mean and maximum duration of the
+ *  callbacks together with a histogram of the durations are recorded. Per spin, the time spent
+ *  in rcl_wait and the time spent in taking data and dispatching callbacks are recorded.
+ *  The statistics are stored in the handles and the executor, i.e. recording does not allocate
+ *  memory. It costs two reads of the steady clock per callback and per spin.
+ *  The statistics are not reset, when recording is enabled or disabled.
+ *  With the multi-threaded executor, it waits until the worker threads have finished all
+ *  running callbacks, so it must not be called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] enable true to record statistics, false to stop recording
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_statistics(
+  rclc_executor_t * executor,
+  bool enable);
+
+/**
+ *  Copies the runtime statistics of a handle into \p statistics and computes the mean
+ *  duration of the callbacks. With the multi-threaded executor, it waits until the worker
+ *  threads have finished all running callbacks, which update the statistics, so it must not
+ *  be called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [in] executor pointer to initialized executor
+ * \param [in] rcl_handle pointer to the rcl-handle (e.g. rcl_subscription_t, rcl_timer_t),
+ *   which was added to the executor
+ * \param [out] statistics statistics of the handle
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the handle is not found in {@link rclc_executor_t.handles}
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_handle_statistics(
+  const rclc_executor_t * executor,
+  const void * rcl_handle,
+  rclc_executor_handle_statistics_t * statistics);
+
+/**
+ *  Copies the runtime statistics of the spins into \p statistics.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to initialized executor
+ * \param [out] statistics statistics of the spins
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_spin_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_spin_statistics_t * statistics);
+
+/**
+ *  Resets the runtime statistics of the spins, of all handles, of the periods of
+ *  {@link rclc_executor_spin_one_period()}, of the busy polling and of the dispatch budget
+ *  and the WCET overrun counters of all handles. With the multi-threaded executor, it waits
+ *  until the worker threads have finished all running callbacks, so it must not be called
+ *  from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_reset_statistics(rclc_executor_t * executor);
+
+/**
+ *  Enables tracing: the executor records binary events (spin start, return of rcl_wait,
+ *  take, start and end of callbacks with the handle id and evaluation of the trigger
+ *  condition) into a preallocated ring of at least \p capacity events. If the ring is full,
+ *  the oldest events are overwritten. Recording an event neither locks nor allocates memory,
+ *  the worker threads of a multi-threaded executor record events concurrently.
+ *  The handle id of an event is the registration number of the handle
+ *  (see {@link rclc_executor_handle_t.registration_number}).
+ *  If tracing is already enabled, the recorded events are discarded.
+ *  Must not be called while the executor is spinning. With the multi-threaded executor, it
+ *  waits until the worker threads have finished all running callbacks, so it must not be
+ *  called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] capacity number of events in the ring (rounded up to a power of two)
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer or capacity is zero
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_enable_trace(
+  rclc_executor_t * executor,
+  size_t capacity);
+
+/**
+ *  Disables tracing and frees the ring of trace events.
+ *  Must not be called while the executor is spinning. With the multi-threaded executor, it
+ *  waits until the worker threads have finished all running callbacks, so it must not be
+ *  called from a callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | No
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_disable_trace(rclc_executor_t * executor);
+
+/**
+ *  Writes the recorded trace events, oldest event first, to the binary file \p path
+ *  (see rclc/executor_trace.h for the format). On POSIX systems the file is written through a
+ *  memory mapping. The file can be converted to the Chrome trace JSON format with the tool
+ *  rclc_trace_to_json. Events, which are recorded while the trace is dumped, may be incomplete.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No (Yes, on platforms without memory mapping)
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to initialized executor
+ * \param [in] path path of the trace file
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if tracing is disabled or the file could not be written
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_dump_trace(
+  const rclc_executor_t * executor,
+  const char * path);
+
+/**
+ *  Cleans up executor.
+ *  Deallocates dynamic memory of {@link rclc_executor_t.handles} and
+ *  resets all other values of {@link rclc_executor_t}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \return `RCL_RET_OK` if reset operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p executor.handles is a null pointer
+ * \return `RCL_RET_ERROR` in an error occured (aka executor was not initialized)
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_fini(rclc_executor_t * executor);
+
+/**
+ *  Adds a subscription to an executor.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg pointer to an allocated message
+ * \param [in] callback    function pointer to a callback
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Adds a subscription to an executor.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg pointer to an allocated message
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription_with_context(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Adds a batched subscription to an executor. In each spin, all messages available
+ *  in the DDS queue of the subscription, but at most \p capacity messages, are taken
+ *  into a contiguous array and the callback is called once with the array and the
+ *  number of received messages. This amortizes per-call setup costs of callbacks, which
+ *  process high-rate topics.
+ *  The message array of \p capacity messages of size \p msg_size is allocated with the
+ *  allocator of the executor, zero-initialized and each message is initialized with \p init.
+ *  The messages are finalized with \p fini and the array is deallocated in
+ *  {@link rclc_executor_remove_subscription()} and {@link rclc_executor_fini()}. Messages with
+ *  fields of unbounded size (e.g. strings or sequences) need \p init and \p fini, so that the
+ *  memory of these fields is released; for other messages both may be NULL.
+ *  If the invocation type is ALWAYS and no message is available, then the callback is
+ *  called with a NULL pointer and count 0.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg_size    size of one message in bytes, e.g. sizeof(std_msgs__msg__Int32)
+ * \param [in] capacity    maximum number of messages, which are processed in one spin
+ * \param [in] init        function, which initializes one message, or NULL
+ * \param [in] fini        function, which finalizes one message, or NULL
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ *   or if \p msg_size or \p capacity is zero
+ * \return `RCL_RET_BAD_ALLOC` if allocating or initializing the messages failed
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription_batch(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  size_t capacity,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_subscription_batch_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Adds a subscription to an executor, which takes messages as loans from the middleware
+ *  with rcl_take_loaned_message, if the middleware supports loaned messages for this
+ *  subscription (see rcl_subscription_can_loan_messages). Then the callback is called with a
+ *  pointer to the loaned message and no copy of the message is made. The loan is returned to the
+ *  middleware after the callback has finished, i.e. the callback must not keep a reference to the
+ *  message. Otherwise, or if taking a loaned message fails, the message is copied into \p msg
+ *  like in {@link rclc_executor_add_subscription_with_context()}.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg         pointer to an allocated message, used if no loan is available
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription_loaned(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Adds a subscription to an executor, which takes the messages in serialized form
+ *  (CDR bytes) with rcl_take_serialized_message and does not deserialize them. This is useful
+ *  for nodes, which only forward or record messages.
+ *  The serialized message is managed by the executor: it is allocated with the allocator of the
+ *  executor with \p initial_capacity bytes and is reused for every message. If a message is
+ *  larger than the buffer, the buffer grows at least by a factor of two. The buffer is
+ *  deallocated in {@link rclc_executor_remove_subscription()} and
+ *  {@link rclc_executor_fini()}. The callback must not keep a reference to the serialized
+ *  message. If the invocation type is ALWAYS and no message is available, then the callback is
+ *  called with a NULL pointer.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] initial_capacity initial size of the buffer of the serialized message in bytes
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_add_subscription_serialized(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  size_t initial_capacity,
+  rclc_subscription_serialized_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
+
+/**
+ *  Adds a subscription with a ring of \p depth preallocated messages to an executor. At the
+ *  sampling point of a spin, all messages available in the DDS queue are taken into the ring,
+ *  overwriting the oldest messages. Then the callback is called once with the last (up to)
+ *  \p depth messages, oldest message first, and the number of messages received in this spin,
+ *  which are the last ones in the array. With the semantics
+ *  RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME all input data is sampled before any callback is
+ *  executed, so the callback processes a consistent snapshot of the messages of the period,
+ *  e.g. for filters, which need every sample and not only the latest one.
+ *  The ring of \p depth messages of size \p msg_size is allocated with the allocator of the
+ *  executor, zero-initialized and each message is initialized with \p init. The messages are
+ *  finalized with \p fini and the ring is deallocated in
+ *  {@link rclc_executor_remove_subscription()} and {@link rclc_executor_fini()}. Messages with
+ *  fields of unbounded size need \p init and \p fini, for other messages both may be NULL
+ *  (see {@link rclc_executor_add_subscription_batch()}). If the invocation type is ALWAYS
+ *  and no new message is available, then the callback is called with the messages of
+ *  previous spins and zero new messages.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   subscription has already been added to the executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
+ *
+ * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
@@ -157,48 +1312,95 @@ rclc_executor_get_zero_initialized_executor(void);
  * Uses Atomics       | No
  * Lock-Free          | Yes
  *
- * \param[inout] executor preallocated rclc_executor_t
- * \param[in] context RCL context
- * \param[in] number_of_handles is the total number of subscriptions, timers, services,
- *  clients and guard conditions. Do not include the number of nodes and publishers.
- * \param[in] allocator allocator for allocating memory
- * \return `RCL_RET_OK` if the executor was initialized successfully
- * \return `RCL_RET_INVALID_ARGUMENT` if any null pointer as argument
- * \return `RCL_RET_ERROR` in case of failure
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg_size    size of one message in bytes, e.g. sizeof(std_msgs__msg__Int32)
+ * \param [in] depth       number of messages in the ring
+ * \param [in] init        function, which initializes one message, or NULL
+ * \param [in] fini        function, which finalizes one message, or NULL
+ * \param [in] callback    function pointer to a callback
+ * \param [in] context     type-erased ptr to additional callback context
+ * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
+ *   or if \p msg_size or \p depth is zero
+ * \return `RCL_RET_BAD_ALLOC` if allocating or initializing the messages failed
+ * \return `RCL_RET_ERROR` if any other error occured
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_init(
+rclc_executor_add_subscription_ring(
   rclc_executor_t * executor,
-  rcl_context_t * context,
-  const size_t number_of_handles,
-  const rcl_allocator_t * allocator);
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  size_t depth,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_subscription_ring_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation);
 
 /**
- *  Set timeout in nanoseconds for rcl_wait (called during {@link rclc_executor_spin_once()}).
+ *  Adds a subscription as input to an approximate-time synchronizer. The subscription is
+ *  added to the executor with a ring of synchronizer->depth preallocated messages (see
+ *  {@link rclc_executor_add_subscription_ring()}), into which the messages are taken directly.
+ *  When new messages were received, they are matched with the buffered messages of the
+ *  other inputs: for each new message, the closest message in time of every other input is
+ *  selected, which is newer than the last matched message of that input. If the difference
+ *  between the newest and the oldest time stamp is at most synchronizer->slop_ns, the callback
+ *  of the synchronizer is called with the tuple and all buffered messages up to the matched
+ *  ones are dropped. The messages of the tuple are only valid during the callback.
+ *  Matching does not allocate memory and its run-time is O(inputs * depth) per new message.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full, if the
+ *   synchronizer has already max_inputs inputs or if its inputs were added to another
+ *   executor.
+ * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
+ *   is incremented by one.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Yes
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
  *
- * \param [inout] executor pointer to an initialized executor
- * \param [in] timeout_ns  timeout in nanoseconds for the rcl_wait (DDS middleware)
- * \return `RCL_RET_OK` if timeout was set successfully
- * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
- * \return `RCL_RET_ERROR` in an error occured
+ * \param [inout] executor pointer to initialized executor
+ * \param [inout] synchronizer pointer to initialized synchronizer
+ * \param [in] subscription pointer to an allocated subscription
+ * \param [in] msg_size    size of one message in bytes, e.g. sizeof(sensor_msgs__msg__Imu)
+ * \param [in] init        function, which initializes one message, or NULL
+ * \param [in] fini        function, which finalizes one message, or NULL
+ * \param [in] stamp       function, which returns the time stamp of a message
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p msg_size is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if any other error occured
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_set_timeout(
+rclc_executor_add_synchronizer_input(
   rclc_executor_t * executor,
-  const uint64_t timeout_ns);
+  rclc_synchronizer_t * synchronizer,
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_synchronizer_stamp_t stamp);
 
 /**
- *  Set data communication semantics
+ *  Sets the maximum number of messages, which are taken from the DDS queue of
+ *  a subscription in one spin. The callback is called once for every taken message.
+ *  With a value larger than one, the executor can keep up with a publisher, which
+ *  publishes with a higher rate than the executor spins, while the limit still
+ *  prevents that a single subscription with high message rate starves all other handles.
+ *  With {@link RCLC_TAKE_UNTIL_EMPTY} all available messages are taken. If a dispatch budget
+ *  is set (see {@link rclc_executor_set_dispatch_budget()}), no further messages are taken,
+ *  once the budget is used up; they stay in the DDS queue for the next spin.
+ *
+ *  The default value is 1. This setting applies only to the data communication semantics
+ *  RCLC_SEMANTICS_RCLCPP_EXECUTOR. With RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME one message
+ *  is taken per subscription at the sampling point.
  *
  * <hr>
  * Attribute          | Adherence
@@ -208,77 +1410,89 @@ rclc_executor_set_timeout(
  * Uses Atomics       | No
  * Lock-Free          | Yes
  *
- * \param [inout] executor pointer to an initialized executor
- * \param [in] valid semantics value as defined in enum type {@link rclc_executor_semantics_t}
- * \return `RCL_RET_OK` if semantics was set successfully
- * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] subscription pointer to a subscription previously added to executor
+ * \param [in] max_takes_per_spin maximum number of messages per spin or RCLC_TAKE_UNTIL_EMPTY
+ * \return `RCL_RET_OK` if the value was set successfully
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if subscription is not found in {@link rclc_executor_t.handles}
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_set_semantics(
+rclc_executor_set_subscription_max_takes(
   rclc_executor_t * executor,
-  rclc_executor_semantics_t semantics);
+  const rcl_subscription_t * subscription,
+  size_t max_takes_per_spin);
 
 /**
- *  Cleans up executor.
- *  Deallocates dynamic memory of {@link rclc_executor_t.handles} and
- *  resets all other values of {@link rclc_executor_t}.
+ *  Adds a timer to an executor.
+ * * An error is returned, if {@link rclc_executor_t.handles} array is full or if the
+ *   timer has already been added to the executor.
+ * * The total number_of_timers field of {@link rclc_executor_t.info} is
+ *   incremented by one.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
+ * Allocates Memory   | No
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
  *
  * \param [inout] executor pointer to initialized executor
- * \return `RCL_RET_OK` if reset operation was successful
- * \return `RCL_RET_INVALID_ARGUMENT` if \p executor is a null pointer
- * \return `RCL_RET_INVALID_ARGUMENT` if \p executor.handles is a null pointer
- * \return `RCL_RET_ERROR` in an error occured (aka executor was not initialized)
+ * \param [in] timer pointer to an allocated timer
+ * \return `RCL_RET_OK` if add-operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if any other error occured
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_fini(rclc_executor_t * executor);
+rclc_executor_add_timer(
+  rclc_executor_t * executor,
+  rcl_timer_t * timer);
 
 /**
- *  Adds a subscription to an executor.
- * * An error is returned, if {@link rclc_executor_t.handles} array is full.
- * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
- *   is incremented by one.
+ *  Enables the timer wheel of the executor for wheel timers (see rclc/timer_wheel.h).
+ *  Wheel timers are managed in a hashed hierarchical timer wheel with the resolution
+ *  \p tick_ns, which is driven by one rcl timer. This rcl timer is added to the executor
+ *  like a timer with {@link rclc_executor_add_timer()}, i.e. it occupies one handle, and the
+ *  callbacks of the expired wheel timers are called in its callback. Therefore the size of
+ *  the wait_set and the cost of a spin do not depend on the number of wheel timers, and
+ *  starting and canceling a wheel timer is O(1). While no wheel timer is started, the rcl
+ *  timer is canceled; it is re-armed by {@link rclc_executor_start_wheel_timer()}.
+ *
+ *  The timer wheel is intended for many timers with coarse periods, e.g. watchdogs.
+ *  Periods are rounded up to multiples of \p tick_ns. The timer wheel is freed in
+ *  {@link rclc_executor_fini()}.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Yes
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
  *
  * \param [inout] executor pointer to initialized executor
- * \param [in] subscription pointer to an allocated subscription
- * \param [in] msg pointer to an allocated message
- * \param [in] callback    function pointer to a callback
- * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
- * \return `RCL_RET_OK` if add-operation was successful
- * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
- * \return `RCL_RET_ERROR` if any other error occured
+ * \param [in] clock clock of the rcl timer, e.g. a steady clock
+ * \param [in] tick_ns resolution of the timer wheel in nanoseconds
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p tick_ns is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ * \return `RCL_RET_ERROR` if the timer wheel is already enabled, the handles array is full
+ *   or any other error occured
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_add_subscription(
+rclc_executor_enable_timer_wheel(
   rclc_executor_t * executor,
-  rcl_subscription_t * subscription,
-  void * msg,
-  rclc_subscription_callback_t callback,
-  rclc_executor_handle_invocation_t invocation);
+  rcl_clock_t * clock,
+  const uint64_t tick_ns);
 
 /**
- *  Adds a subscription to an executor.
- * * An error is returned, if {@link rclc_executor_t.handles} array is full.
- * * The total number_of_subscriptions field of {@link rclc_executor_t.info}
- *   is incremented by one.
+ *  Starts a wheel timer. It expires after its period (rounded up to full ticks) and is called
+ *  by the executor. A started timer is restarted. Can be called in callbacks, also in the
+ *  callback of a wheel timer.
  *
  * <hr>
  * Attribute          | Adherence
@@ -289,30 +1503,20 @@ rclc_executor_add_subscription(
  * Lock-Free          | Yes
  *
  * \param [inout] executor pointer to initialized executor
- * \param [in] subscription pointer to an allocated subscription
- * \param [in] msg pointer to an allocated message
- * \param [in] callback    function pointer to a callback
- * \param [in] context     type-erased ptr to additional callback context
- * \param [in] invocation  invocation type for the callback (ALWAYS or only ON_NEW_DATA)
- * \return `RCL_RET_OK` if add-operation was successful
- * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is ignored)
- * \return `RCL_RET_ERROR` if any other error occured
+ * \param [inout] timer wheel timer initialized with {@link rclc_wheel_timer_init()}
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if the timer wheel is not enabled or any other error occured
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_add_subscription_with_context(
+rclc_executor_start_wheel_timer(
   rclc_executor_t * executor,
-  rcl_subscription_t * subscription,
-  void * msg,
-  rclc_subscription_callback_with_context_t callback,
-  void * context,
-  rclc_executor_handle_invocation_t invocation);
+  rclc_wheel_timer_t * timer);
 
 /**
- *  Adds a timer to an executor.
- * * An error is returned, if {@link rclc_executor_t.handles} array is full.
- * * The total number_of_timers field of {@link rclc_executor_t.info} is
- *   incremented by one.
+ *  Cancels a wheel timer. Canceling a timer, which is not started, has no effect.
+ *  Can be called in callbacks, also in the callback of a wheel timer.
  *
  * <hr>
  * Attribute          | Adherence
@@ -323,21 +1527,22 @@ rclc_executor_add_subscription_with_context(
  * Lock-Free          | Yes
  *
  * \param [inout] executor pointer to initialized executor
- * \param [in] timer pointer to an allocated timer
- * \return `RCL_RET_OK` if add-operation was successful
+ * \param [inout] timer wheel timer
+ * \return `RCL_RET_OK` if successful
  * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
- * \return `RCL_RET_ERROR` if any other error occured
+ * \return `RCL_RET_ERROR` if the timer wheel is not enabled
  */
 RCLC_PUBLIC
 rcl_ret_t
-rclc_executor_add_timer(
+rclc_executor_cancel_wheel_timer(
   rclc_executor_t * executor,
-  rcl_timer_t * timer);
+  rclc_wheel_timer_t * timer);
 
 
 /**
  *  Adds a client to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   client has already been added to the executor.
  * * The total number_of_clients field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -367,7 +1572,8 @@ rclc_executor_add_client(
 
 /**
  *  Adds a client to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   client has already been added to the executor.
  * * The total number_of_clients field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -397,7 +1603,8 @@ rclc_executor_add_client_with_request_id(
 
 /**
  *  Adds a service to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   service has already been added to the executor.
  * * The total number_of_services field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -508,7 +1715,8 @@ rclc_executor_add_action_server(
 
 /**
  *  Adds a service to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   service has already been added to the executor.
  * * The total number_of_services field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -540,7 +1748,8 @@ rclc_executor_add_service_with_request_id(
 
 /**
  *  Adds a service to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   service has already been added to the executor.
  * * The total number_of_services field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -574,7 +1783,8 @@ rclc_executor_add_service_with_context(
 
 /**
  *  Adds a guard_condition to an executor.
- * * An error is returned if {@link rclc_executor_t.handles} array is full.
+ * * An error is returned if {@link rclc_executor_t.handles} array is full or if the
+ *   guard condition has already been added to the executor.
  * * The total number_of_guard_conditions field of {@link rclc_executor_t.info}
  *   is incremented by one.
  *
@@ -743,6 +1953,14 @@ rclc_executor_remove_guard_condition(
  *  The executor prepare function prepare the waitset of the executor if
  *  it is invalid. Does nothing if a valid waitset is already prepared.
  *
+ *  When the waitset is prepared, the rcl-handles are sorted by type into
+ *  {@link rclc_executor_t.wait_set_entities} and the index of each handle in the
+ *  waitset is computed. Then the spin-methods refill the waitset from this array
+ *  without evaluating every handle again. This is only repeated, if handles are
+ *  added or removed. Likewise, the order in which the handles are processed
+ *  ({@link rclc_executor_t.dispatch_order}) is computed only if handles are added or
+ *  removed or priorities have changed.
+ *
  * Memory is dynamically allocated within rcl-layer, when DDS queue is accessed with rcl_wait_set_init()
  *
  * <hr>
@@ -788,7 +2006,8 @@ rclc_executor_prepare(
  *
  *
  * \param [inout] executor pointer to initialized executor
- * \param[in] timeout_ns  timeout in nanoseconds
+ * \param[in] timeout_ns  timeout in nanoseconds, RCLC_EXECUTOR_WAIT_FOREVER (or any value
+ *                        larger than INT64_MAX) to wait until a handle is ready
  * \return `RCL_RET_OK` if spin_once operation was successful
  * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
  * \return `RCL_RET_TIMEOUT` if rcl_wait() returned timeout (aka no data is avaiable during until the timeout)
@@ -800,9 +2019,42 @@ rclc_executor_spin_some(
   rclc_executor_t * executor,
   const uint64_t timeout_ns);
 
+/**
+ *  Same as {@link rclc_executor_spin_some()}, but with the dispatch budget \p budget_ns for
+ *  this spin instead of the budget of {@link rclc_executor_set_dispatch_budget()}. If the
+ *  budget is used up, the remaining ready handles are deferred to the next spin.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] timeout_ns timeout in nanoseconds
+ * \param [in] budget_ns dispatch budget in nanoseconds, 0 for no budget
+ * \return `RCL_RET_OK` if spin_once operation was successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p budget_ns is
+ *   larger than INT64_MAX
+ * \return `RCL_RET_TIMEOUT` if rcl_wait() returned timeout
+ * \return `RCL_RET_ERROR` if \p budget_ns is not 0 and the worker threads of a
+ *   multi-threaded executor are running, or if any other error occured
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_spin_some_with_budget(
+  rclc_executor_t * executor,
+  const uint64_t timeout_ns,
+  const uint64_t budget_ns);
+
 /**
  *  The spin function checks for new data at DDS queue as long as ros context is available.
  *  It calls {@link rclc_executor_spin_some()} as long as rcl_context_is_valid() returns true.
+ *  The timeout of each spin is returned by {@link rclc_executor_get_wait_timeout()}, i.e.
+ *  rcl_wait sleeps until the next timer is due, if the tickless wait is enabled with
+ *  {@link rclc_executor_set_tickless_wait()}.
  *
  *  Memory is dynamically allocated within rcl-layer, when DDS queue is accessed with rcl_wait_set_init()
  *  (in spin_some function)
@@ -829,6 +2081,10 @@ rclc_executor_spin(rclc_executor_t * executor);
  *  The spin_period function checks for new data at DDS queue as long as ros context is available.
  *  It is called every period nanoseconds.
  *  It calls {@link rclc_executor_spin_some()} as long as rcl_context_is_valid() returns true.
+ *  The period is measured with a monotonic clock and the executor sleeps until the absolute
+ *  time point of the next period (see {@link rclc_sleep_until_ns()}), so that the
+ *  period does not drift. Overruns are handled according to
+ *  {@link rclc_executor_set_period_overrun_policy()}.
  *
  *  Memory is dynamically allocated within rcl-layer, when DDS queue is accessed with rcl_wait_set_init()
  *  (in spin_some function)
@@ -882,9 +2138,64 @@ rclc_executor_spin_one_period(
   rclc_executor_t * executor,
   const uint64_t period);
 
+/**
+ *  Sets the behavior of {@link rclc_executor_spin_one_period()}, if a spin takes longer than
+ *  the period. With RCLC_PERIOD_OVERRUN_CATCH_UP (default) the following spins start
+ *  immediately until the executor is back on schedule, with RCLC_PERIOD_OVERRUN_SKIP the
+ *  missed periods are skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] policy overrun policy
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if executor is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_period_overrun_policy(
+  rclc_executor_t * executor,
+  rclc_executor_period_overrun_policy_t policy);
+
+/**
+ *  Copies the statistics of {@link rclc_executor_spin_one_period()} into \p statistics:
+ *  number of periods, overruns and skipped periods and the minimum, maximum, last and total
+ *  jitter (delay of the start of a spin after its scheduled time point).
+ *  The statistics are reset with {@link rclc_executor_reset_statistics()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] executor pointer to initialized executor
+ * \param [out] statistics statistics of the periods
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_get_period_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_period_statistics_t * statistics);
+
 /**
  * Set the trigger condition.
  *
+ * The built-in trigger functions (rclc_executor_trigger_all, rclc_executor_trigger_any,
+ * rclc_executor_trigger_one, rclc_executor_trigger_always, rclc_executor_trigger_expression
+ * and rclc_executor_trigger_deadline) are evaluated by the executor on the ready bitmap of the
+ * current spin. User-defined trigger functions are called with the array of all handles.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -1008,6 +2319,120 @@ rclc_executor_trigger_one(
   unsigned int size,
   void * obj);
 
+/**
+ *  Sets a trigger expression as trigger condition, e.g. "(A and B) or C". The rcl-handles
+ *  of the expression are compiled into bitmasks over the handles of the executor, which are
+ *  evaluated with word-wide operations on the ready bitmap in every spin. The expression is
+ *  compiled again, when handles are added to or removed from the executor. A rcl-handle,
+ *  which is not (or no more) in the executor, is never ready.
+ *  This is equivalent to rclc_executor_set_trigger(executor,
+ *  rclc_executor_trigger_expression, expression).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] expression initialized trigger expression, which must stay valid while it is
+ *   the trigger condition of the executor
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or the expression was
+ *   initialized for less handles than the executor
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_trigger_expression(
+  rclc_executor_t * executor,
+  rclc_trigger_expression_t * expression);
+
+/**
+ * Trigger condition: expression, returns true if the trigger expression obj
+ * (rclc_trigger_expression_t) is fulfilled. If it is called by the executor, the compiled
+ * bitmasks are evaluated on the ready bitmap. If it is called directly, the rcl-handles of the
+ * expression are searched in \p handles.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] handles pointer to array of handles
+ * \param [in] size size of array
+ * \param [in] obj trigger expression set by rclc_executor_set_trigger_expression
+ * \return true if the trigger expression is fulfilled
+ * \return false otherwise
+ */
+RCLC_PUBLIC
+bool
+rclc_executor_trigger_expression(
+  rclc_executor_handle_t * handles,
+  unsigned int size,
+  void * obj);
+
+/**
+ *  Sets a deadline trigger as trigger condition: the callbacks are processed when all inputs
+ *  of the trigger are ready or when its maximum waiting time has elapsed since the first input
+ *  became ready, whichever comes first. In the second case only the callbacks of the ready
+ *  inputs are called; the callbacks can check with {@link rclc_trigger_deadline_is_fresh()},
+ *  which inputs are fresh. The inputs are compiled into a bitmask like a trigger expression.
+ *  This is equivalent to rclc_executor_set_trigger(executor,
+ *  rclc_executor_trigger_deadline, trigger).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] executor pointer to initialized executor
+ * \param [in] trigger initialized deadline trigger, which must stay valid while it is the
+ *   trigger condition of the executor
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or the trigger was
+ *   initialized for less handles than the executor
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_executor_set_trigger_deadline(
+  rclc_executor_t * executor,
+  rclc_trigger_deadline_t * trigger);
+
+/**
+ * Trigger condition: deadline, returns true if all inputs of the deadline trigger obj
+ * (rclc_trigger_deadline_t) are ready or if its maximum waiting time has elapsed since the
+ * first input became ready. If it is called directly, the rcl-handles of the inputs are
+ * searched in \p handles.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] handles pointer to array of handles
+ * \param [in] size size of array
+ * \param [in] obj deadline trigger set by rclc_executor_set_trigger_deadline
+ * \return true if the trigger is fulfilled
+ * \return false otherwise
+ */
+RCLC_PUBLIC
+bool
+rclc_executor_trigger_deadline(
+  rclc_executor_handle_t * handles,
+  unsigned int size,
+  void * obj);
+
 #if __cplusplus
 }
 #endif
@@ -47,6 +47,11 @@ typedef enum
   RCLC_ACTION_SERVER,
   RCLC_GUARD_CONDITION,
   // RCLC_GUARD_CONDITION_WITH_CONTEXT,  //TODO
+  // new types are appended to keep the values of the existing types
+  RCLC_SUBSCRIPTION_BATCH,
+  RCLC_SUBSCRIPTION_LOANED,
+  RCLC_SUBSCRIPTION_SERIALIZED,
+  RCLC_SUBSCRIPTION_RING,
   RCLC_NONE
 } rclc_executor_handle_type_t;
 
@@ -58,6 +63,10 @@ typedef enum
   ALWAYS
 } rclc_executor_handle_invocation_t;
 
+/// Value of {@link rclc_executor_handle_t.max_takes_per_spin}: a subscription takes
+/// all messages from the DDS queue in one spin.
+#define RCLC_TAKE_UNTIL_EMPTY 0
+
 /// Type definition for subscription callback function
 /// - incoming message
 typedef void (* rclc_subscription_callback_t)(const void *);
@@ -71,6 +80,28 @@ typedef rclc_subscription_callback_t rclc_callback_t;
 /// - additional callback context
 typedef void (* rclc_subscription_callback_with_context_t)(const void *, void *);
 
+/// Type definition for batched subscription callback function
+/// - array of incoming messages
+/// - number of messages in the array
+/// - additional callback context
+typedef void (* rclc_subscription_batch_callback_t)(const void *, size_t, void *);
+
+/// Type definition for the function, which initializes a message of a message array allocated
+/// by the executor, e.g. a wrapper of the generated function std_msgs__msg__String__init.
+/// Returns false, if the message could not be initialized.
+typedef bool (* rclc_message_init_t)(void *);
+
+/// Type definition for the function, which finalizes a message of a message array allocated
+/// by the executor, e.g. a wrapper of the generated function std_msgs__msg__String__fini.
+typedef void (* rclc_message_fini_t)(void *);
+
+/// Type definition for subscription ring callback function
+/// - array of pointers to the buffered messages, oldest message first
+/// - number of messages in the array
+/// - number of messages, which have been received in the current spin (the last ones in the array)
+/// - additional callback context
+typedef void (* rclc_subscription_ring_callback_t)(const void * const *, size_t, size_t, void *);
+
 /// Type definition for client callback function
 /// - request message
 /// - response message
@@ -88,6 +119,11 @@ typedef void (* rclc_service_callback_with_request_id_t)(const void *, rmw_reque
 /// - additional service context
 typedef void (* rclc_service_callback_with_context_t)(const void *, void *, void *);
 
+/// Type definition for serialized subscription callback function
+/// - serialized message (CDR bytes in buffer, number of bytes in buffer_length)
+/// - additional callback context
+typedef void (* rclc_subscription_serialized_callback_t)(const rcl_serialized_message_t *, void *);
+
 /// Type definition for client callback function
 /// - response message
 typedef void (* rclc_client_callback_t)(const void *);
@@ -100,6 +136,56 @@ typedef void (* rclc_client_callback_with_request_id_t)(const void *, rmw_reques
 /// Type definition for guard condition callback function.
 typedef void (* rclc_gc_callback_t)();
 
+/// Trace ring of an executor (opaque).
+struct rclc_executor_trace_s;
+
+/// Type definition for the overrun callback, which is called when a callback ran longer than
+/// the worst-case execution time of its handle (see rclc_executor_set_handle_wcet)
+/// - rcl-handle of the handle (e.g. rcl_subscription_t, rcl_timer_t)
+/// - measured duration of the callback in nanoseconds
+/// - worst-case execution time of the handle in nanoseconds
+/// - context (see rclc_executor_set_overrun_callback)
+typedef void (* rclc_executor_overrun_callback_t)(const void *, uint64_t, uint64_t, void *);
+
+/// Monitoring configuration of an executor. It exists once per executor and is passed to the
+/// execution of every handle, so that changing it does not touch the handles.
+typedef struct
+{
+  /// callback, which is called if a callback overruns the worst-case execution time of its
+  /// handle, NULL if not set
+  rclc_executor_overrun_callback_t overrun_callback;
+  /// context of the overrun callback
+  void * overrun_context;
+  /// Flag, which is true, if runtime statistics are recorded
+  bool statistics_enabled;
+  /// Preallocated ring of trace events, NULL if tracing is disabled
+  struct rclc_executor_trace_s * trace;
+} rclc_executor_monitoring_t;
+
+/// Number of buckets of the callback duration histogram
+#define RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE 32
+
+/// Runtime statistics of a handle, which are recorded if statistics are enabled
+/// (see rclc_executor_enable_statistics).
+typedef struct
+{
+  /// Number of callback invocations
+  uint64_t invocations;
+  /// Number of takes, which returned no message (or request/response)
+  uint64_t take_failures;
+  /// Minimum duration of a callback in nanoseconds
+  uint64_t callback_time_min_ns;
+  /// Maximum duration of a callback in nanoseconds
+  uint64_t callback_time_max_ns;
+  /// Sum of the durations of all callbacks in nanoseconds
+  uint64_t callback_time_total_ns;
+  /// Mean duration of a callback in nanoseconds (computed by rclc_executor_get_handle_statistics)
+  uint64_t callback_time_mean_ns;
+  /// Histogram of the callback durations: bucket k counts durations in [2^k, 2^(k+1)) ns,
+  /// bucket 0 also durations of 0 ns and the last bucket all longer durations.
+  uint64_t callback_time_histogram[RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE];
+} rclc_executor_handle_statistics_t;
+
 
 /// Container for a handle.
 typedef struct
@@ -120,6 +206,7 @@ typedef struct
   };
   /// Storage of data, which holds the message of a subscription, service, etc.
   /// subscription: ptr to message
+  /// serialized subscription: ptr to rcl_serialized_message_t
   /// service: ptr to request message
   void * data;
 
@@ -132,6 +219,26 @@ typedef struct
   /// ptr to additional callback context
   void * callback_context;
 
+  /// only for batched subscription and subscription ring - size of one message in bytes
+  size_t data_msg_size;
+  /// only for batched subscription and subscription ring - maximum number of messages in data
+  size_t data_capacity;
+  /// only for batched subscription and subscription ring - number of messages taken in the
+  /// current spin
+  size_t data_count;
+  /// only for batched subscription and subscription ring - function, which finalizes the
+  /// messages in data before they are deallocated, NULL if they need no finalization
+  rclc_message_fini_t data_fini;
+  /// only for subscription ring - position in data, at which the next message is taken
+  size_t data_ring_head;
+  /// only for subscription ring - number of valid messages in data
+  size_t data_ring_size;
+  /// only for subscription ring - pointers to the valid messages in data, oldest message first
+  const void ** data_ring_snapshot;
+  /// only for loaned subscription - message loaned from the middleware in the current spin,
+  /// NULL if the message was copied into data
+  void * data_loaned;
+
   // TODO(jst3si) new type to be stored as data for
   //              service/client objects
   //              look at memory allocation for this struct!
@@ -145,6 +252,9 @@ typedef struct
   union {
     rclc_subscription_callback_t subscription_callback;
     rclc_subscription_callback_with_context_t subscription_callback_with_context;
+    rclc_subscription_batch_callback_t subscription_batch_callback;
+    rclc_subscription_ring_callback_t subscription_ring_callback;
+    rclc_subscription_serialized_callback_t subscription_serialized_callback;
     rclc_service_callback_t service_callback;
     rclc_service_callback_with_request_id_t service_callback_with_reqid;
     rclc_service_callback_with_context_t service_callback_with_context;
@@ -162,13 +272,54 @@ typedef struct
   size_t index;
   /// Internal variable. Flag, which is true, if the handle is initialized and therefore initialized
   bool initialized;
+  /// Internal variable. Increasing number, which is assigned when the handle is added to the
+  /// executor. Handles are processed in the order of their registration number.
+  size_t registration_number;
   /// Interval variable. Flag, which is true, if new data is available from DDS queue
   /// (is set after calling rcl_take)
   bool data_available;
+  /// Maximum number of messages, which are taken from the DDS queue and processed in one spin.
+  /// Only for subscriptions (default: 1). RCLC_TAKE_UNTIL_EMPTY takes all available messages.
+  size_t max_takes_per_spin;
+  /// Priority of the callback, only used if priority scheduling is enabled. Handles with higher
+  /// priority are processed first, handles with equal priority in the order they were added.
+  int priority;
+  /// Relative deadline in nanoseconds, only used by the earliest-deadline-first semantics.
+  /// 0 denotes no deadline.
+  rcutils_duration_value_t deadline;
+  /// Internal variable. Absolute deadline of the current job (release time plus deadline)
+  rcutils_time_point_value_t absolute_deadline;
+  /// Number of callback executions, which finished after their absolute deadline
+  size_t deadline_misses;
+  /// Expected worst-case execution time of the callback in nanoseconds, 0 if not monitored
+  uint64_t wcet_ns;
+  /// Number of callback executions, which took longer than wcet_ns
+  uint64_t wcet_overruns;
+  /// Longest measured duration of a callback execution, which took longer than wcet_ns
+  uint64_t wcet_worst_ns;
+  /// Runtime statistics (only recorded if statistics are enabled in the executor)
+  rclc_executor_handle_statistics_t statistics;
+  /// Internal variable. Flag, which is true, if the handle was ready, but not executed,
+  /// because the dispatch budget of the spin was used up (see rclc_executor_set_dispatch_budget)
+  bool deferred;
   /// pointer to custom handle
   void * custom;
 } rclc_executor_handle_t;
 
+/// Internal. Data of a handle, which is read in every spin to check for new data (hot data).
+/// The executor keeps these entries in a dense array in dispatch order, so that the scan over
+/// all handles does not touch the large rclc_executor_handle_t of handles without new data.
+typedef struct
+{
+  /// Pointer to the entry of the handle in the wait_set (e.g. &wait_set.subscriptions[index]),
+  /// NULL for action clients and action servers, which are checked with the complete handle
+  const void * const * wait_set_entry;
+  /// Index of the handle in the executor handle array
+  size_t handle_index;
+  /// Flag, which is true, if the callback is invoked ALWAYS
+  bool always;
+} rclc_executor_handle_hot_t;
+
 /// Information about total number of subscriptions, guard_conditions, timers, subscription etc.
 typedef struct
 {
@@ -212,7 +363,10 @@ rclc_executor_handle_counters_zero_init(rclc_executor_handle_counters_t * handle
  *  Initializes a handle with default values. The {@link rclc_executor_handle_t.index}
  *  is initialized with `max_handles`, which is a non-valid index. Note that, valid indicies
  *  are [0,max-handles-1]. The {@link rclc_executor_handle_t.invocation} is set to `ON_NEW_DATA`,
- *  so that a potential callback is invoced only whenever new data is received. All other member
+ *  so that a potential callback is invoced only whenever new data is received. The
+ *  {@link rclc_executor_handle_t.max_takes_per_spin} is set to 1, the
+ *  {@link rclc_executor_handle_t.priority} to 0 and the {@link rclc_executor_handle_t.deadline}
+ *  to 0 (no deadline). All other member
  *  fields are set appropriate default values, like `none`, `NULL` or `false`.
  *
  *  * <hr>
@@ -258,6 +412,43 @@ rclc_executor_handle_clear(
   rclc_executor_handle_t * handle,
   size_t max_handles);
 
+/**
+ *  Resets the runtime statistics of a handle.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] statistics preallocated statistics
+ */
+RCLC_PUBLIC
+void
+rclc_executor_handle_statistics_reset(rclc_executor_handle_statistics_t * statistics);
+
+/**
+ *  Records the duration of one callback invocation in the runtime statistics of a handle.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] statistics preallocated statistics
+ * \param[in] duration_ns duration of the callback in nanoseconds
+ */
+RCLC_PUBLIC
+void
+rclc_executor_handle_statistics_record(
+  rclc_executor_handle_statistics_t * statistics,
+  uint64_t duration_ns);
+
 /**
  *  Print out type name of a rclc_executor_handle_t.
  *
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_TRACE_H_
+#define RCLC__EXECUTOR_TRACE_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*! \file executor_trace.h
+    \brief Binary format of the event trace of the RCLC-Executor, which is written by
+    rclc_executor_dump_trace() and converted to the Chrome trace JSON format by the tool
+    rclc_trace_to_json.
+*/
+
+/// Magic number at the beginning of a trace file ("RCLCTRC" and the format version)
+#define RCLC_EXECUTOR_TRACE_MAGIC "RCLCTRC1"
+
+/// Handle id of events, which do not belong to a handle
+#define RCLC_EXECUTOR_TRACE_NO_HANDLE UINT32_MAX
+
+/// Types of trace events
+typedef enum
+{
+  /// start of a spin, value: 0
+  RCLC_EXECUTOR_TRACE_SPIN_START,
+  /// return of rcl_wait, value: return code of rcl_wait
+  RCLC_EXECUTOR_TRACE_WAIT_RETURN,
+  /// take of new data of a handle, value: return code of the take
+  RCLC_EXECUTOR_TRACE_TAKE,
+  /// start of the callback of a handle, value: 0
+  RCLC_EXECUTOR_TRACE_CALLBACK_START,
+  /// end of the callback of a handle, value: 0
+  RCLC_EXECUTOR_TRACE_CALLBACK_END,
+  /// evaluation of the trigger condition, value: 1 if the trigger condition is fulfilled
+  RCLC_EXECUTOR_TRACE_TRIGGER
+} rclc_executor_trace_event_type_t;
+
+/// One trace event (fixed size of 24 bytes)
+typedef struct
+{
+  /// steady time in nanoseconds
+  int64_t timestamp_ns;
+  /// rclc_executor_trace_event_type_t
+  uint32_t type;
+  /// registration number of the handle or RCLC_EXECUTOR_TRACE_NO_HANDLE
+  uint32_t handle_id;
+  /// value depending on the type of the event
+  int64_t value;
+} rclc_executor_trace_event_t;
+
+/// Header of a trace file, which is followed by event_count events, oldest event first
+typedef struct
+{
+  /// RCLC_EXECUTOR_TRACE_MAGIC (not null-terminated)
+  char magic[8];
+  /// size of one event in bytes
+  uint32_t event_size;
+  /// capacity of the trace ring in events
+  uint32_t capacity;
+  /// number of events in the file
+  uint64_t event_count;
+  /// number of older events, which have been overwritten in the trace ring
+  uint64_t dropped_count;
+} rclc_executor_trace_file_header_t;
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_TRACE_H_
@@ -108,6 +108,143 @@ rclc_publisher_init(
   const char * topic_name,
   const rmw_qos_profile_t * qos_profile);
 
+/// Container for publishing messages, which are loaned from the middleware. If the
+/// middleware does not support loaned messages, a preallocated message is used instead.
+typedef struct
+{
+  /// publisher, which publishes the messages
+  const rcl_publisher_t * publisher;
+  /// type support of the published message type
+  const rosidl_message_type_support_t * type_support;
+  /// preallocated message, which is used if no message can be loaned
+  void * fallback_msg;
+  /// message, which is currently borrowed by the user (NULL if none)
+  void * borrowed_msg;
+  /// true, if borrowed_msg has been loaned from the middleware
+  bool is_loaned;
+} rclc_publisher_loan_t;
+
+/**
+ *  Initializes a container for publishing loaned messages with \p publisher.
+ *  The message \p fallback_msg must be initialized by the user and is used, if the
+ *  middleware can not loan a message. It must stay valid until
+ *  {@link rclc_publisher_loan_fini()} is called.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] loan the container for loaned messages
+ * \param[in] publisher an initialized publisher
+ * \param[in] type_support the message data type of the publisher
+ * \param[in] fallback_msg preallocated message of the message data type
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_publisher_loan_init(
+  rclc_publisher_loan_t * loan,
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void * fallback_msg);
+
+/**
+ *  Borrows a message, which is filled in place by the user and then published with
+ *  {@link rclc_publisher_publish_borrowed_message()}. If the middleware supports loaned
+ *  messages, the message is loaned from the middleware with rcl_borrow_loaned_message and
+ *  published without copy. Otherwise the preallocated message is returned. A loaned message is
+ *  not initialized, i.e. all fields have to be set by the user. Only one message can be
+ *  borrowed at a time.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes (in the middleware)
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] loan an initialized container for loaned messages
+ * \param[out] msg pointer to the borrowed message
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer
+ * \return `RCL_RET_ERROR` if a message is already borrowed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_publisher_borrow_message(
+  rclc_publisher_loan_t * loan,
+  void ** msg);
+
+/**
+ *  Publishes the borrowed message: a loaned message with rcl_publish_loaned_message, which
+ *  passes the ownership of the message back to the middleware, otherwise the preallocated
+ *  message with rcl_publish. The message must not be used afterwards.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] loan an initialized container for loaned messages
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if loan is a null pointer
+ * \return `RCL_RET_ERROR` if no message is borrowed
+ * \return `RCL_RET_ERROR` (or other error code) if publishing failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_publisher_publish_borrowed_message(rclc_publisher_loan_t * loan);
+
+/**
+ *  Returns the borrowed message without publishing it.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] loan an initialized container for loaned messages
+ * \return `RCL_RET_OK` if successful or if no message is borrowed
+ * \return `RCL_RET_INVALID_ARGUMENT` if loan is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if an error has occurred
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_publisher_return_borrowed_message(rclc_publisher_loan_t * loan);
+
+/**
+ *  Returns a borrowed message and resets the container. The preallocated message is not
+ *  finalized.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] loan an initialized container for loaned messages
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if loan is a null pointer
+ * \return `RCL_RET_ERROR` (or other error code) if an error has occurred
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_publisher_loan_fini(rclc_publisher_loan_t * loan);
+
 #if __cplusplus
 }
 #endif
@@ -21,6 +21,8 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
 #include "rclc/visibility_control.h"
 
 /**
@@ -41,6 +43,47 @@ void
 rclc_sleep_ms(
   unsigned int ms);
 
+/**
+ *  Returns the current time of the monotonic clock, which is used by
+ *  {@link rclc_sleep_until_ns()}, in nanoseconds. The clock does not jump, when the system time
+ *  is adjusted.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \return current time in nanoseconds
+ */
+RCLC_PUBLIC
+int64_t
+rclc_monotonic_time_ns(void);
+
+/**
+ *  Waits until the absolute time point \p time_point_ns of the clock of
+ *  {@link rclc_monotonic_time_ns()}. Returns immediately, if the time point has passed.
+ *  On Linux clock_nanosleep with TIMER_ABSTIME is used, so that the wake-up time does not
+ *  drift by the time spent between reading the clock and going to sleep. On other platforms
+ *  the remaining time is slept relatively.
+ *
+ *  * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] time_point_ns absolute time point in nanoseconds
+ */
+RCLC_PUBLIC
+void
+rclc_sleep_until_ns(
+  int64_t time_point_ns);
+
 #if __cplusplus
 }
 #endif
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__SYNCHRONIZER_H_
+#define RCLC__SYNCHRONIZER_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/allocator.h>
+#include <rcl/subscription.h>
+#include <rcl/types.h>
+
+#include "rclc/executor_handle.h"
+
+#include "rclc/visibility_control.h"
+
+/*! \file synchronizer.h
+    \brief Approximate-time synchronizer of the RCLC-Executor, which matches the messages of
+    several subscriptions by their time stamps and calls one callback with the matched tuple
+    (see rclc_executor_add_synchronizer_input()).
+*/
+
+/// Type definition for the function, which returns the time stamp of a message in
+/// nanoseconds, e.g. for a message with a std_msgs/Header:
+/// header.stamp.sec * 1000000000 + header.stamp.nanosec
+typedef int64_t (* rclc_synchronizer_stamp_t)(const void *);
+
+/// Type definition for the callback of a synchronizer
+/// - array of pointers to the matched messages, one per input in the order of the inputs
+/// - number of inputs
+/// - additional callback context
+typedef void (* rclc_synchronizer_callback_t)(const void * const *, size_t, void *);
+
+struct rclc_synchronizer_s;
+struct rclc_executor_t_s;
+
+/// Input of a synchronizer.
+typedef struct
+{
+  /// synchronizer of the input
+  struct rclc_synchronizer_s * synchronizer;
+  /// subscription of the input
+  rcl_subscription_t * subscription;
+  /// function, which returns the time stamp of a message of the input
+  rclc_synchronizer_stamp_t stamp;
+  /// Internal variable. Time stamp of the last matched message, messages with an older or
+  /// equal time stamp are not matched any more
+  int64_t last_stamp;
+} rclc_synchronizer_input_t;
+
+/// Approximate-time synchronizer. The memory of the struct is provided by the application and
+/// must stay valid while the executor is used.
+typedef struct rclc_synchronizer_s
+{
+  /// number of buffered messages per input
+  size_t depth;
+  /// maximum difference in nanoseconds between the time stamps of the messages of a tuple
+  uint64_t slop_ns;
+  /// callback, which is called with the matched tuple
+  rclc_synchronizer_callback_t callback;
+  /// application specific context passed to the callback
+  void * context;
+  /// inputs of the synchronizer
+  rclc_synchronizer_input_t * inputs;
+  /// number of inputs
+  size_t size;
+  /// maximum number of inputs
+  size_t capacity;
+  /// Internal variable. Matched tuple, which is passed to the callback
+  const void ** tuple;
+  /// Internal variable. Time stamps of the messages of the tuple
+  int64_t * tuple_stamps;
+  /// Number of matched tuples
+  uint64_t matches;
+  /// Internal variable. Executor, to which the inputs were added
+  struct rclc_executor_t_s * executor;
+  /// allocator used for the inputs and the tuple
+  const rcl_allocator_t * allocator;
+} rclc_synchronizer_t;
+
+/**
+ *  Return a rclc_synchronizer_t struct with members set to `NULL` or 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ */
+RCLC_PUBLIC
+rclc_synchronizer_t
+rclc_synchronizer_get_zero_initialized_synchronizer(void);
+
+/**
+ *  Initializes an approximate-time synchronizer for up to \p max_inputs inputs, which buffer
+ *  the last \p depth messages each. All memory is allocated here, matching the messages
+ *  in the spin of the executor does not allocate memory. A tuple is matched, if the
+ *  difference between the newest and the oldest time stamp of its messages is at most
+ *  \p slop_ns. The inputs are added with {@link rclc_executor_add_synchronizer_input()}.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] synchronizer zero-initialized synchronizer
+ * \param [in] max_inputs maximum number of inputs
+ * \param [in] depth number of buffered messages per input
+ * \param [in] slop_ns maximum difference of the time stamps of a tuple in nanoseconds
+ * \param [in] callback function, which is called with the matched tuple
+ * \param [in] context application specific context passed to the callback
+ * \param [in] allocator allocator for the inputs and the tuple
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer (NULL context is
+ *   ignored) or if \p max_inputs or \p depth is 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_synchronizer_init(
+  rclc_synchronizer_t * synchronizer,
+  size_t max_inputs,
+  size_t depth,
+  uint64_t slop_ns,
+  rclc_synchronizer_callback_t callback,
+  void * context,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Removes the inputs of a synchronizer from the executor, if the executor has not been
+ *  finalized before, and deallocates the memory of the synchronizer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] synchronizer synchronizer
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p synchronizer is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_synchronizer_fini(rclc_synchronizer_t * synchronizer);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__SYNCHRONIZER_H_
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__TIMER_WHEEL_H_
+#define RCLC__TIMER_WHEEL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rcl/types.h>
+
+#include "rclc/visibility_control.h"
+
+/*! \file timer_wheel.h
+    \brief Lightweight timers of the RCLC-Executor, which are managed in a hierarchical timer
+    wheel and driven by one rcl timer per executor (see rclc_executor_enable_timer_wheel()).
+*/
+
+typedef struct rclc_wheel_timer_s rclc_wheel_timer_t;
+
+/// Type definition for the callback of a wheel timer
+/// - the expired timer
+/// - context of the timer (see rclc_wheel_timer_init)
+typedef void (* rclc_wheel_timer_callback_t)(rclc_wheel_timer_t *, void *);
+
+/// Timer of the timer wheel of an executor. The memory is provided by the application and must
+/// stay valid while the timer is started.
+struct rclc_wheel_timer_s
+{
+  /// period (or timeout of a one-shot timer) in nanoseconds
+  uint64_t period_ns;
+  /// Flag, which is true, if the timer is started again after it expired
+  bool periodic;
+  /// callback, which is called when the timer expired
+  rclc_wheel_timer_callback_t callback;
+  /// application specific context passed to the callback
+  void * context;
+  /// Internal variable. Flag, which is true, while the timer is started
+  bool active;
+  /// Internal variable. Period in ticks of the timer wheel
+  uint64_t period_ticks;
+  /// Internal variable. Tick of the timer wheel, at which the timer expires
+  uint64_t expiry_tick;
+  /// Internal variable. Head of the slot list, in which the timer is stored
+  rclc_wheel_timer_t ** slot;
+  /// Internal variable. Next timer in the slot list
+  rclc_wheel_timer_t * next;
+  /// Internal variable. Previous timer in the slot list
+  rclc_wheel_timer_t * prev;
+};
+
+/**
+ *  Initializes a wheel timer. The timer is started with
+ *  {@link rclc_executor_start_wheel_timer()}. Must not be called for a started timer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [out] timer timer to be initialized
+ * \param [in] period_ns period in nanoseconds, it is rounded up to a multiple of the tick
+ * \param [in] periodic true for a periodic timer, false for a one-shot timer
+ * \param [in] callback function, which is called when the timer expired
+ * \param [in] context application specific context passed to the callback
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p timer or \p callback is a null pointer or
+ *   \p period_ns is 0
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_wheel_timer_init(
+  rclc_wheel_timer_t * timer,
+  uint64_t period_ns,
+  bool periodic,
+  rclc_wheel_timer_callback_t callback,
+  void * context);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__TIMER_WHEEL_H_
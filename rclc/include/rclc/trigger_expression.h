@@ -0,0 +1,331 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__TRIGGER_EXPRESSION_H_
+#define RCLC__TRIGGER_EXPRESSION_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rcl/allocator.h>
+#include <rcl/types.h>
+
+#include "rclc/visibility_control.h"
+
+/*! \file trigger_expression.h
+    \brief Trigger conditions of the RCLC-Executor, which combine groups of handles with AND
+    and OR (see rclc_executor_set_trigger_expression()) or wait for a group of handles with a
+    deadline (see rclc_executor_set_trigger_deadline()). They are compiled into bitmasks over
+    the handles of the executor and evaluated with word-wide operations on the ready bitmap of
+    the executor.
+*/
+
+/// Number of 64-bit words of a bitmap with one bit per handle for \p n handles
+#define RCLC_TRIGGER_BITMAP_WORDS(n) (((n) + 63) / 64)
+
+/** Operator of a trigger group or of a trigger expression
+ *  RCLC_TRIGGER_ALL - true, if all operands are true (AND)
+ *  RCLC_TRIGGER_ANY - true, if at least one operand is true (OR)
+ */
+typedef enum
+{
+  RCLC_TRIGGER_ALL,
+  RCLC_TRIGGER_ANY
+} rclc_trigger_operator_t;
+
+/// Group of handles of a trigger expression, combined with one operator.
+typedef struct
+{
+  /// operator, with which the ready states of the handles are combined
+  rclc_trigger_operator_t op;
+  /// rcl-handles (e.g. rcl_subscription_t, rcl_timer_t) of the group, the array is provided
+  /// by the application and must stay valid while the expression is used
+  const void * const * rcl_handles;
+  /// number of rcl-handles
+  size_t size;
+  /// Internal variable. Bitmask of the handles in the handle array of the executor
+  uint64_t * mask;
+  /// Internal variable. Flag, which is true, if all rcl-handles were found in the executor
+  bool complete;
+} rclc_trigger_group_t;
+
+/// Trigger expression: the groups are combined with one operator, e.g. the expression
+/// "(A and B) or C" consists of the groups ALL{A, B} and ALL{C} combined with RCLC_TRIGGER_ANY.
+typedef struct
+{
+  /// operator, with which the groups are combined
+  rclc_trigger_operator_t op;
+  /// groups of the expression
+  rclc_trigger_group_t * groups;
+  /// number of groups
+  size_t size;
+  /// maximum number of groups
+  size_t capacity;
+  /// number of 64-bit words of a bitmask
+  size_t words;
+  /// Internal variable. Memory of the bitmasks of all groups
+  uint64_t * masks;
+  /// allocator used for groups and masks
+  const rcl_allocator_t * allocator;
+} rclc_trigger_expression_t;
+
+/// Trigger, which is fulfilled when all inputs are ready or when the maximum waiting time
+/// since the first ready input has elapsed, whichever comes first.
+typedef struct
+{
+  /// inputs of the trigger (operator RCLC_TRIGGER_ALL)
+  rclc_trigger_group_t inputs;
+  /// maximum waiting time in nanoseconds after the first input became ready
+  uint64_t max_wait_ns;
+  /// number of 64-bit words of the bitmask of the inputs
+  size_t words;
+  /// Internal variable. Flag, which is true, if at least one input is ready and the trigger
+  /// is waiting for the other inputs
+  bool waiting;
+  /// Internal variable. Time of rclc_monotonic_time_ns, at which the first input became ready
+  int64_t first_input_time_ns;
+  /// Internal variable. fresh[i] is true, if inputs.rcl_handles[i] was ready, when the trigger
+  /// was fulfilled the last time
+  bool * fresh;
+  /// Number of times, the trigger was fulfilled because the maximum waiting time elapsed
+  uint64_t expirations;
+  /// allocator used for the bitmask and fresh
+  const rcl_allocator_t * allocator;
+} rclc_trigger_deadline_t;
+
+/**
+ *  Return a rclc_trigger_expression_t struct with members set to `NULL` or 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ */
+RCLC_PUBLIC
+rclc_trigger_expression_t
+rclc_trigger_expression_get_zero_initialized_expression(void);
+
+/**
+ *  Initializes a trigger expression and allocates the memory for \p max_groups groups with
+ *  bitmasks for \p max_handles handles, which must be at least the number of handles of the
+ *  executor, on which the expression is used.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] expression zero-initialized trigger expression
+ * \param [in] op operator, with which the groups are combined
+ * \param [in] max_groups maximum number of groups
+ * \param [in] max_handles maximum number of handles of the executor
+ * \param [in] allocator allocator for the groups and bitmasks
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or 0
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_trigger_expression_init(
+  rclc_trigger_expression_t * expression,
+  rclc_trigger_operator_t op,
+  size_t max_groups,
+  size_t max_handles,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Adds a group of handles to a trigger expression. The rcl-handles are resolved to handles
+ *  of the executor, when the expression is set as trigger condition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] expression initialized trigger expression
+ * \param [in] op operator, with which the ready states of the handles are combined
+ * \param [in] rcl_handles array of rcl-handles, which must stay valid while the expression
+ *   is used
+ * \param [in] size number of rcl-handles
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer or \p size is 0
+ * \return `RCL_RET_ERROR` if the expression has already \p max_groups groups
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_trigger_expression_add_group(
+  rclc_trigger_expression_t * expression,
+  rclc_trigger_operator_t op,
+  const void * const * rcl_handles,
+  size_t size);
+
+/**
+ *  Evaluates a compiled trigger expression on a bitmap with one bit per handle of the
+ *  executor. Groups with rcl-handles, which are not in the executor, are never fulfilled
+ *  with RCLC_TRIGGER_ALL.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] expression compiled trigger expression
+ * \param [in] ready_bitmap bitmap of the ready handles
+ * \param [in] words number of 64-bit words of \p ready_bitmap, at most expression->words
+ * \return true if the expression is fulfilled
+ * \return false otherwise
+ */
+RCLC_PUBLIC
+bool
+rclc_trigger_expression_evaluate(
+  const rclc_trigger_expression_t * expression,
+  const uint64_t * ready_bitmap,
+  size_t words);
+
+/**
+ *  Deallocates the memory of a trigger expression.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] expression trigger expression
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p expression is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_trigger_expression_fini(rclc_trigger_expression_t * expression);
+
+/**
+ *  Return a rclc_trigger_deadline_t struct with members set to `NULL` or 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ */
+RCLC_PUBLIC
+rclc_trigger_deadline_t
+rclc_trigger_deadline_get_zero_initialized_deadline(void);
+
+/**
+ *  Initializes a deadline trigger for the inputs \p rcl_handles. The trigger is fulfilled
+ *  when all inputs are ready or when \p max_wait_ns have elapsed since the first input became
+ *  ready. The bitmask is allocated for \p max_handles handles, which must be at least the
+ *  number of handles of the executor, on which the trigger is used.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] trigger zero-initialized deadline trigger
+ * \param [in] rcl_handles array of rcl-handles (e.g. rcl_subscription_t), which must stay
+ *   valid while the trigger is used
+ * \param [in] size number of rcl-handles
+ * \param [in] max_wait_ns maximum waiting time in nanoseconds after the first ready input
+ * \param [in] max_handles maximum number of handles of the executor
+ * \param [in] allocator allocator for the bitmask and the fresh flags
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if any parameter is a null pointer, \p size or
+ *   \p max_handles is 0 or \p max_wait_ns is larger than INT64_MAX
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_trigger_deadline_init(
+  rclc_trigger_deadline_t * trigger,
+  const void * const * rcl_handles,
+  size_t size,
+  uint64_t max_wait_ns,
+  size_t max_handles,
+  const rcl_allocator_t * allocator);
+
+/**
+ *  Returns, if the input \p rcl_handle was ready, when the deadline trigger was fulfilled the
+ *  last time. In the callbacks, which are executed because of the trigger, inputs, which are
+ *  not fresh, have not received new data.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [in] trigger initialized deadline trigger
+ * \param [in] rcl_handle rcl-handle of an input
+ * \return true if the input is fresh
+ * \return false otherwise or if \p rcl_handle is not an input of the trigger
+ */
+RCLC_PUBLIC
+bool
+rclc_trigger_deadline_is_fresh(
+  const rclc_trigger_deadline_t * trigger,
+  const void * rcl_handle);
+
+/**
+ *  Deallocates the memory of a deadline trigger.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param [inout] trigger deadline trigger
+ * \return `RCL_RET_OK` if successful
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p trigger is a null pointer
+ */
+RCLC_PUBLIC
+rcl_ret_t
+rclc_trigger_deadline_fini(rclc_trigger_deadline_t * trigger);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__TRIGGER_EXPRESSION_H_
@@ -15,12 +15,19 @@
 // limitations under the License.
 
 #include "rclc/executor.h"
+#include <stdint.h>
+#include <string.h>
 #include <rcutils/time.h>
+#include <rmw/serialized_message.h>
 
 #include "./action_generic_types.h"
 #include "./action_goal_handle_internal.h"
 #include "./action_client_internal.h"
 #include "./action_server_internal.h"
+#include "./executor_internal.h"
+#include "./executor_timer_wheel_internal.h"
+#include "./executor_trace_internal.h"
+#include "./executor_worker_pool_internal.h"
 
 // Include backport of function 'rcl_wait_set_is_valid' introduced in Foxy
 // in case of building for Dashing and Eloquent. This pre-processor macro
@@ -56,6 +63,11 @@ rcl_ret_t
 _rclc_let_scheduling(rclc_executor_t * executor, rcl_wait_set_t * wait_set);
 */
 
+/// execute callback of handle (also called by the worker threads)
+static
+rcl_ret_t
+_rclc_execute(rclc_executor_handle_t * handle, const rclc_executor_monitoring_t * monitoring);
+
 // rationale: user must create an executor with:
 // executor = rclc_executor_get_zero_initialized_executor();
 // then handles==NULL or not (e.g. properly initialized)
@@ -75,6 +87,245 @@ _rclc_executor_is_valid(rclc_executor_t * executor)
   return true;
 }
 
+// marks an empty entry of executor->handle_map
+#define RCLC_EXECUTOR_HANDLE_MAP_EMPTY SIZE_MAX
+
+/***
+ * hash function of executor->handle_map, the key is the pointer to the rcl-handle
+ */
+static
+size_t
+_rclc_executor_handle_map_hash(const rclc_executor_t * executor, const void * key)
+{
+  // rcl-handles are aligned: drop the low bits and mix the remaining bits
+  uintptr_t h = ((uintptr_t) key) >> 3;
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return ((size_t) h) & executor->handle_map_mask;
+}
+
+/***
+ * returns the position of the rcl-handle \p key in executor->handle_map or
+ * RCLC_EXECUTOR_HANDLE_MAP_EMPTY, if it is not in the map.
+ */
+static
+size_t
+_rclc_executor_handle_map_find(const rclc_executor_t * executor, const void * key)
+{
+  size_t pos = _rclc_executor_handle_map_hash(executor, key);
+  while (executor->handle_map[pos] != RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    if (rclc_executor_handle_get_ptr(&executor->handles[executor->handle_map[pos]]) == key) {
+      return pos;
+    }
+    pos = (pos + 1) & executor->handle_map_mask;
+  }
+  return RCLC_EXECUTOR_HANDLE_MAP_EMPTY;
+}
+
+/***
+ * inserts executor->handles[handle_index] into executor->handle_map. Action clients and action
+ * servers are not inserted, because they can not be looked up by an rcl-handle. The add-functions
+ * reject an rcl-handle, which is already in the map (see _rclc_executor_handle_is_added).
+ */
+static
+void
+_rclc_executor_handle_map_insert(rclc_executor_t * executor, size_t handle_index)
+{
+  const void * key = rclc_executor_handle_get_ptr(&executor->handles[handle_index]);
+  if (NULL == key) {
+    return;
+  }
+  size_t pos = _rclc_executor_handle_map_hash(executor, key);
+  while (executor->handle_map[pos] != RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    if (rclc_executor_handle_get_ptr(&executor->handles[executor->handle_map[pos]]) == key) {
+      return;
+    }
+    pos = (pos + 1) & executor->handle_map_mask;
+  }
+  executor->handle_map[pos] = handle_index;
+}
+
+/***
+ * removes the entry at position \p pos from executor->handle_map. The following entries
+ * of the same probe sequence are shifted back, so that no tombstones are needed.
+ */
+static
+void
+_rclc_executor_handle_map_erase(rclc_executor_t * executor, size_t pos)
+{
+  size_t * map = executor->handle_map;
+  size_t mask = executor->handle_map_mask;
+  size_t next = pos;
+
+  map[pos] = RCLC_EXECUTOR_HANDLE_MAP_EMPTY;
+  while (true) {
+    next = (next + 1) & mask;
+    if (map[next] == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+      return;
+    }
+    size_t home = _rclc_executor_handle_map_hash(
+      executor, rclc_executor_handle_get_ptr(&executor->handles[map[next]]));
+    // the entry can be moved to pos, if its home position is not in the range (pos, next]
+    bool in_range = (pos <= next) ? ((pos < home) && (home <= next)) :
+      ((pos < home) || (home <= next));
+    if (!in_range) {
+      map[pos] = map[next];
+      map[next] = RCLC_EXECUTOR_HANDLE_MAP_EMPTY;
+      pos = next;
+    }
+  }
+}
+
+/***
+ * returns true, if the rcl-handle \p rcl_handle has already been added to the executor.
+ * Adding it twice is rejected, because executor->handle_map refers to one handle per
+ * rcl-handle.
+ */
+static
+bool
+_rclc_executor_handle_is_added(const rclc_executor_t * executor, const void * rcl_handle)
+{
+  return _rclc_executor_handle_map_find(executor, rcl_handle) != RCLC_EXECUTOR_HANDLE_MAP_EMPTY;
+}
+
+/***
+ * adds executor->handles[executor->index], which has been filled by an add-function,
+ * to executor->handle_map and increases executor->index
+ */
+static
+void
+_rclc_executor_register_handle(rclc_executor_t * executor)
+{
+  executor->handles[executor->index].registration_number = executor->next_registration_number++;
+  _rclc_executor_handle_map_insert(executor, executor->index);
+  executor->index++;
+}
+
+/***
+ * waits until no callback is executed by a worker thread of a multi-threaded executor, e.g.
+ * before data is changed, which the worker threads read in _rclc_execute. Must not be called
+ * from a callback.
+ */
+static
+void
+_rclc_executor_wait_for_workers(const rclc_executor_t * executor)
+{
+  if (NULL != executor->worker_pool) {
+    rclc_executor_worker_pool_wait_idle(executor->worker_pool);
+  }
+}
+
+/***
+ * allocates and deallocates the serialized message of a serialized subscription
+ */
+static
+rcl_serialized_message_t *
+_rclc_executor_serialized_message_create(rclc_executor_t * executor, size_t capacity)
+{
+  rcl_serialized_message_t * msg = executor->allocator->allocate(
+    sizeof(rcl_serialized_message_t), executor->allocator->state);
+  if (NULL == msg) {
+    return NULL;
+  }
+  *msg = rmw_get_zero_initialized_serialized_message();
+  if (rmw_serialized_message_init(msg, capacity, executor->allocator) != RMW_RET_OK) {
+    executor->allocator->deallocate(msg, executor->allocator->state);
+    return NULL;
+  }
+  return msg;
+}
+
+static
+void
+_rclc_executor_serialized_message_destroy(
+  rclc_executor_t * executor,
+  rcl_serialized_message_t * msg)
+{
+  if (NULL == msg) {
+    return;
+  }
+  rmw_ret_t rc = rmw_serialized_message_fini(msg);
+  if (rc != RMW_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_serialized_message_destroy, rmw_serialized_message_fini);
+  }
+  executor->allocator->deallocate(msg, executor->allocator->state);
+}
+
+/***
+ * returns the loaned message of a loaned subscription, which has not been returned after a
+ * callback, e.g. because the handle was deferred or the spin was aborted by an error.
+ * If returning the loan fails, the handle keeps it.
+ */
+static
+rcl_ret_t
+_rclc_executor_return_pending_loan(rclc_executor_handle_t * handle)
+{
+  if ((handle->type != RCLC_SUBSCRIPTION_LOANED) || (NULL == handle->data_loaned)) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t rc = rcl_return_loaned_message_from_subscription(
+    handle->subscription, handle->data_loaned);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(
+      rclc_executor_return_pending_loan, rcl_return_loaned_message_from_subscription);
+    return rc;
+  }
+  handle->data_loaned = NULL;
+  return RCL_RET_OK;
+}
+
+/***
+ * allocates a zero-initialized array of \p count messages of size \p msg_size and initializes
+ * the messages with \p init (if not NULL). If a message cannot be initialized, the messages
+ * initialized before are finalized with \p fini and the array is deallocated.
+ */
+static
+void *
+_rclc_executor_message_array_create(
+  rclc_executor_t * executor,
+  size_t count,
+  size_t msg_size,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini)
+{
+  uint8_t * msgs = executor->allocator->zero_allocate(
+    count, msg_size, executor->allocator->state);
+  if ((NULL == msgs) || (NULL == init)) {
+    return msgs;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (!init(msgs + i * msg_size)) {
+      for (size_t j = 0; (NULL != fini) && (j < i); j++) {
+        fini(msgs + j * msg_size);
+      }
+      executor->allocator->deallocate(msgs, executor->allocator->state);
+      return NULL;
+    }
+  }
+  return msgs;
+}
+
+/***
+ * finalizes the messages of the message array of a batched subscription or subscription ring
+ * with handle->data_fini (if not NULL) and deallocates the array.
+ */
+static
+void
+_rclc_executor_message_array_destroy(
+  rclc_executor_t * executor,
+  rclc_executor_handle_t * handle)
+{
+  if (NULL == handle->data) {
+    return;
+  }
+  for (size_t i = 0; (NULL != handle->data_fini) && (i < handle->data_capacity); i++) {
+    handle->data_fini((uint8_t *) handle->data + i * handle->data_msg_size);
+  }
+  executor->allocator->deallocate(handle->data, executor->allocator->state);
+  handle->data = NULL;
+}
+
 // wait_set and rclc_executor_handle_size_t are structs and cannot be statically
 // initialized here.
 rclc_executor_t
@@ -89,7 +340,15 @@ rclc_executor_get_zero_initialized_executor()
     .timeout_ns = 0,
     .invocation_time = 0,
     .trigger_function = NULL,
-    .trigger_object = NULL
+    .trigger_object = NULL,
+    .monitoring = {
+      .overrun_callback = NULL,
+      .overrun_context = NULL,
+      .statistics_enabled = false,
+      .trace = NULL
+    },
+    .worker_pool = NULL,
+    .timer_wheel = NULL
   };
   return null_executor;
 }
@@ -118,6 +377,13 @@ rclc_executor_init(
   executor->wait_set = rcl_get_zero_initialized_wait_set();
   executor->allocator = allocator;
   executor->timeout_ns = DEFAULT_WAIT_TIMEOUT_NS;
+  executor->tickless_wait = false;
+  executor->tickless_max_timeout_ns = 0;
+  executor->type = RCLC_EXECUTOR_SINGLE_THREADED;
+  executor->worker_pool = NULL;
+  executor->timer_wheel = NULL;
+  executor->worker_scheduling = RCLC_WORKER_SCHEDULING_WORK_STEALING;
+  executor->worker_guard_condition = rcl_get_zero_initialized_guard_condition();
   // allocate memory for the array
   executor->handles =
     executor->allocator->allocate(
@@ -128,6 +394,129 @@ rclc_executor_init(
     return RCL_RET_BAD_ALLOC;
   }
 
+  // allocate memory for the rcl-handles of the wait_set
+  executor->wait_set_entities.entities =
+    executor->allocator->allocate(
+    (number_of_handles * sizeof(void *)),
+    executor->allocator->state);
+  if (NULL == executor->wait_set_entities.entities) {
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'wait_set_entities'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // allocate memory for the processing order of the handles
+  executor->dispatch_order =
+    executor->allocator->allocate(
+    (number_of_handles * sizeof(size_t)),
+    executor->allocator->state);
+  if (NULL == executor->dispatch_order) {
+    executor->allocator->deallocate(
+      executor->wait_set_entities.entities,
+      executor->allocator->state);
+    executor->wait_set_entities.entities = NULL;
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'dispatch_order'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  executor->dispatch_order_is_valid = false;
+  executor->priority_scheduling = false;
+
+  // allocate memory for the hot data of the handles
+  executor->hot_handles =
+    executor->allocator->allocate(
+    (number_of_handles * sizeof(rclc_executor_handle_hot_t)),
+    executor->allocator->state);
+  if (NULL == executor->hot_handles) {
+    executor->allocator->deallocate(executor->dispatch_order, executor->allocator->state);
+    executor->dispatch_order = NULL;
+    executor->allocator->deallocate(
+      executor->wait_set_entities.entities,
+      executor->allocator->state);
+    executor->wait_set_entities.entities = NULL;
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'hot_handles'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // allocate memory for the ready handles of a spin, the handles deferred to the next spin
+  // and the ready bitmap. The bitmap starts after an even number of size_t entries and is
+  // therefore aligned to 8 bytes.
+  size_t ready_bitmap_words = RCLC_TRIGGER_BITMAP_WORDS(number_of_handles);
+  executor->ready_list =
+    executor->allocator->allocate(
+    (2 * number_of_handles * sizeof(size_t)) + (ready_bitmap_words * sizeof(uint64_t)),
+    executor->allocator->state);
+  if (NULL == executor->ready_list) {
+    executor->allocator->deallocate(executor->hot_handles, executor->allocator->state);
+    executor->hot_handles = NULL;
+    executor->allocator->deallocate(executor->dispatch_order, executor->allocator->state);
+    executor->dispatch_order = NULL;
+    executor->allocator->deallocate(
+      executor->wait_set_entities.entities,
+      executor->allocator->state);
+    executor->wait_set_entities.entities = NULL;
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'ready_list'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  executor->ready_list_size = 0;
+  executor->deferred_list = executor->ready_list + number_of_handles;
+  executor->deferred_list_size = 0;
+  executor->carried_over_size = 0;
+  executor->deferred_runnable = false;
+  executor->ready_bitmap = (uint64_t *) (executor->ready_list + 2 * number_of_handles);
+  executor->ready_bitmap_words = ready_bitmap_words;
+  memset(executor->ready_bitmap, 0, ready_bitmap_words * sizeof(uint64_t));
+  executor->dispatch_budget_ns = 0;
+  executor->dispatch_start_ns = 0;
+  memset(&executor->budget_statistics, 0, sizeof(rclc_executor_budget_statistics_t));
+  executor->deadline_misses = 0;
+  executor->monitoring.overrun_callback = NULL;
+  executor->monitoring.overrun_context = NULL;
+  executor->monitoring.statistics_enabled = false;
+  memset(&executor->spin_statistics, 0, sizeof(rclc_executor_spin_statistics_t));
+  executor->period_overrun_policy = RCLC_PERIOD_OVERRUN_CATCH_UP;
+  memset(&executor->period_statistics, 0, sizeof(rclc_executor_period_statistics_t));
+  executor->busy_poll_ns = 0;
+  memset(&executor->busy_poll_statistics, 0, sizeof(rclc_executor_busy_poll_statistics_t));
+
+  // allocate memory for the hash table of the handles: power of two, at most half full
+  size_t handle_map_size = 2;
+  while (handle_map_size < 2 * number_of_handles) {
+    handle_map_size *= 2;
+  }
+  executor->handle_map =
+    executor->allocator->allocate(
+    (handle_map_size * sizeof(size_t)),
+    executor->allocator->state);
+  if (NULL == executor->handle_map) {
+    executor->allocator->deallocate(executor->ready_list, executor->allocator->state);
+    executor->ready_list = NULL;
+    executor->allocator->deallocate(executor->hot_handles, executor->allocator->state);
+    executor->hot_handles = NULL;
+    executor->allocator->deallocate(executor->dispatch_order, executor->allocator->state);
+    executor->dispatch_order = NULL;
+    executor->allocator->deallocate(
+      executor->wait_set_entities.entities,
+      executor->allocator->state);
+    executor->wait_set_entities.entities = NULL;
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for 'handle_map'.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < handle_map_size; i++) {
+    executor->handle_map[i] = RCLC_EXECUTOR_HANDLE_MAP_EMPTY;
+  }
+  executor->handle_map_mask = handle_map_size - 1;
+  executor->next_registration_number = 0;
+  executor->wait_set_entities_is_valid = false;
+
   // initialize handle
   for (size_t i = 0; i < number_of_handles; i++) {
     rclc_executor_handle_init(&executor->handles[i], number_of_handles);
@@ -162,1550 +551,3513 @@ rclc_executor_set_timeout(rclc_executor_t * executor, const uint64_t timeout_ns)
 }
 
 rcl_ret_t
-rclc_executor_set_semantics(rclc_executor_t * executor, rclc_executor_semantics_t semantics)
+rclc_executor_set_tickless_wait(
+  rclc_executor_t * executor,
+  bool enable,
+  const uint64_t max_timeout_ns)
 {
   RCL_CHECK_FOR_NULL_WITH_MSG(
     executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t ret = RCL_RET_OK;
-  if (_rclc_executor_is_valid(executor)) {
-    executor->data_comm_semantics = semantics;
-  } else {
+  if (!_rclc_executor_is_valid(executor)) {
     RCL_SET_ERROR_MSG("executor not initialized.");
     return RCL_RET_ERROR;
   }
-  return ret;
+  executor->tickless_wait = enable;
+  executor->tickless_max_timeout_ns = max_timeout_ns;
+  return RCL_RET_OK;
 }
 
-
 rcl_ret_t
-rclc_executor_fini(rclc_executor_t * executor)
+rclc_executor_get_wait_timeout(
+  const rclc_executor_t * executor,
+  uint64_t * timeout_ns)
 {
-  if (_rclc_executor_is_valid(executor)) {
-    executor->allocator->deallocate(executor->handles, executor->allocator->state);
-    executor->handles = NULL;
-    executor->max_handles = 0;
-    executor->index = 0;
-    rclc_executor_handle_counters_zero_init(&executor->info);
-
-    // free memory of wait_set if it has been initialized
-    // calling it with un-initialized wait_set will fail.
-    if (rcl_wait_set_is_valid(&executor->wait_set)) {
-      rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
-      if (rc != RCL_RET_OK) {
-        PRINT_RCLC_ERROR(rclc_executor_fini, rcl_wait_set_fini);
-      }
-    }
-    executor->timeout_ns = DEFAULT_WAIT_TIMEOUT_NS;
-  } else {
-    // Repeated calls to fini or calling fini on a zero initialized executor is ok
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timeout_ns, RCL_RET_INVALID_ARGUMENT);
+  if (!executor->tickless_wait) {
+    *timeout_ns = executor->timeout_ns;
+    return RCL_RET_OK;
   }
+
+  // rcl_wait itself limits the timeout to the next call of the earliest timer in the
+  // wait_set, so the timers do not need to be scanned here
+  *timeout_ns = (executor->tickless_max_timeout_ns > 0) ?
+    executor->tickless_max_timeout_ns : RCLC_EXECUTOR_WAIT_FOREVER;
   return RCL_RET_OK;
 }
 
-
 rcl_ret_t
-rclc_executor_add_subscription(
+rclc_executor_set_busy_poll(
   rclc_executor_t * executor,
-  rcl_subscription_t * subscription,
-  void * msg,
-  rclc_subscription_callback_t callback,
-  rclc_executor_handle_invocation_t invocation)
+  const uint64_t busy_poll_ns)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t ret = RCL_RET_OK;
-  // array bound check
-  if (executor->index >= executor->max_handles) {
-    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return RCL_RET_ERROR;
+  if (busy_poll_ns > (uint64_t) INT64_MAX) {
+    RCL_SET_ERROR_MSG("busy-poll window is too large");
+    return RCL_RET_INVALID_ARGUMENT;
   }
+  executor->busy_poll_ns = busy_poll_ns;
+  return RCL_RET_OK;
+}
 
-  // assign data fields
-  executor->handles[executor->index].type = RCLC_SUBSCRIPTION;
-  executor->handles[executor->index].subscription = subscription;
-  executor->handles[executor->index].data = msg;
-  executor->handles[executor->index].subscription_callback = callback;
-  executor->handles[executor->index].invocation = invocation;
-  executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = NULL;
-  executor->handles[executor->index].data_available = false;
-
-  // increase index of handle array
-  executor->index++;
+rcl_ret_t
+rclc_executor_get_busy_poll_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_busy_poll_statistics_t * statistics)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  *statistics = executor->busy_poll_statistics;
+  return RCL_RET_OK;
+}
 
-  // invalidate wait_set so that in next spin_some() call the
-  // 'executor->wait_set' is updated accordingly
-  if (rcl_wait_set_is_valid(&executor->wait_set)) {
-    ret = rcl_wait_set_fini(&executor->wait_set);
-    if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription.");
-      return ret;
-    }
+rcl_ret_t
+rclc_executor_set_dispatch_budget(
+  rclc_executor_t * executor,
+  const uint64_t budget_ns)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  if (budget_ns > (uint64_t) INT64_MAX) {
+    RCL_SET_ERROR_MSG("dispatch budget is too large");
+    return RCL_RET_INVALID_ARGUMENT;
   }
-
-  executor->info.number_of_subscriptions++;
-
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
-  return ret;
+  if ((budget_ns > 0) && (NULL != executor->worker_pool)) {
+    RCL_SET_ERROR_MSG("dispatch budget is not supported by the multi-threaded executor");
+    return RCL_RET_ERROR;
+  }
+  executor->dispatch_budget_ns = budget_ns;
+  return RCL_RET_OK;
 }
 
-
 rcl_ret_t
-rclc_executor_add_subscription_with_context(
-  rclc_executor_t * executor,
-  rcl_subscription_t * subscription,
-  void * msg,
-  rclc_subscription_callback_with_context_t callback,
-  void * context,
-  rclc_executor_handle_invocation_t invocation)
+rclc_executor_get_budget_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_budget_statistics_t * statistics)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  *statistics = executor->budget_statistics;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_semantics(rclc_executor_t * executor, rclc_executor_semantics_t semantics)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-  // array bound check
-  if (executor->index >= executor->max_handles) {
-    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+  if ((semantics != RCLC_SEMANTICS_RCLCPP_EXECUTOR) && (NULL != executor->worker_pool)) {
+    RCL_SET_ERROR_MSG("multi-threaded executor supports only RCLC_SEMANTICS_RCLCPP_EXECUTOR");
     return RCL_RET_ERROR;
   }
+  if (_rclc_executor_is_valid(executor)) {
+    executor->data_comm_semantics = semantics;
+  } else {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  return ret;
+}
 
-  // assign data fields
-  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_WITH_CONTEXT;
-  executor->handles[executor->index].subscription = subscription;
-  executor->handles[executor->index].data = msg;
-  executor->handles[executor->index].subscription_callback_with_context = callback;
-  executor->handles[executor->index].invocation = invocation;
-  executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = context;
 
-  // increase index of handle array
-  executor->index++;
+rcl_ret_t
+rclc_executor_set_worker_threads(rclc_executor_t * executor, size_t number_of_threads)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (!_rclc_executor_is_valid(executor)) {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  // the worker threads dispatch the ready handles with RCLCPP_EXECUTOR semantics
+  if ((number_of_threads > 0) &&
+    ((executor->data_comm_semantics != RCLC_SEMANTICS_RCLCPP_EXECUTOR) ||
+    (executor->dispatch_budget_ns > 0)))
+  {
+    RCL_SET_ERROR_MSG(
+      "multi-threaded executor supports only RCLC_SEMANTICS_RCLCPP_EXECUTOR without "
+      "dispatch budget");
+    return RCL_RET_ERROR;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
 
-  // invalidate wait_set so that in next spin_some() call the
-  // 'executor->wait_set' is updated accordingly
+  // stop running worker threads
+  if (NULL != executor->worker_pool) {
+    ret = rclc_executor_worker_pool_fini(executor->worker_pool);
+    executor->worker_pool = NULL;
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_worker_threads, rclc_executor_worker_pool_fini);
+    }
+    ret = rcl_guard_condition_fini(&executor->worker_guard_condition);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_worker_threads, rcl_guard_condition_fini);
+    }
+    executor->worker_guard_condition = rcl_get_zero_initialized_guard_condition();
+    executor->type = RCLC_EXECUTOR_SINGLE_THREADED;
+  }
+
+  if (number_of_threads > 0) {
+    rcl_guard_condition_options_t options = rcl_guard_condition_get_default_options();
+    options.allocator = *executor->allocator;
+    ret = rcl_guard_condition_init(
+      &executor->worker_guard_condition, executor->context, options);
+    if (RCL_RET_OK != ret) {
+      PRINT_RCLC_ERROR(rclc_executor_set_worker_threads, rcl_guard_condition_init);
+      return ret;
+    }
+    // every handle is dispatched at most once at a time
+    ret = rclc_executor_worker_pool_init(
+      &executor->worker_pool, number_of_threads, executor->handles, executor->max_handles,
+      executor->worker_scheduling, _rclc_execute, &executor->monitoring,
+      &executor->worker_guard_condition, executor->allocator);
+    if (RCL_RET_OK != ret) {
+      rcl_ret_t rc_fini = rcl_guard_condition_fini(&executor->worker_guard_condition);
+      RCLC_UNUSED(rc_fini);
+      executor->worker_guard_condition = rcl_get_zero_initialized_guard_condition();
+      executor->worker_pool = NULL;
+      return ret;
+    }
+    executor->type = RCLC_EXECUTOR_MULTI_THREADED;
+  }
+
+  // the size of the wait_set has changed
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_with_context.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_set_worker_threads.");
       return ret;
     }
   }
-
-  executor->info.number_of_subscriptions++;
-
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_timer(
+rclc_executor_set_worker_scheduling(
   rclc_executor_t * executor,
-  rcl_timer_t * timer)
+  rclc_executor_worker_scheduling_t scheduling)
 {
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
+  if (_rclc_executor_is_valid(executor)) {
+    executor->worker_scheduling = scheduling;
+  } else {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  return ret;
+}
 
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+rcl_ret_t
+rclc_executor_set_priority_scheduling(rclc_executor_t * executor, bool enable)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor, "executor is null pointer", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  if (_rclc_executor_is_valid(executor)) {
+    executor->priority_scheduling = enable;
+    executor->dispatch_order_is_valid = false;
+  } else {
+    RCL_SET_ERROR_MSG("executor not initialized.");
+    return RCL_RET_ERROR;
+  }
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_fini(rclc_executor_t * executor)
+{
+  if (_rclc_executor_is_valid(executor)) {
+    // wait for running callbacks and stop the worker threads
+    if (NULL != executor->worker_pool) {
+      rcl_ret_t rc = rclc_executor_set_worker_threads(executor, 0);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rclc_executor_set_worker_threads);
+      }
+    }
+    // free message arrays of batched subscriptions and subscription rings and
+    // buffers of serialized subscriptions, return pending loans
+    for (size_t i = 0; i < executor->index; i++) {
+      if (executor->handles[i].type == RCLC_SUBSCRIPTION_LOANED) {
+        rcl_ret_t rc = _rclc_executor_return_pending_loan(&executor->handles[i]);
+        RCLC_UNUSED(rc);
+      } else if (executor->handles[i].type == RCLC_SUBSCRIPTION_BATCH) {
+        _rclc_executor_message_array_destroy(executor, &executor->handles[i]);
+      } else if (executor->handles[i].type == RCLC_SUBSCRIPTION_SERIALIZED) {
+        _rclc_executor_serialized_message_destroy(executor, executor->handles[i].data);
+      } else if (executor->handles[i].type == RCLC_SUBSCRIPTION_RING) {
+        _rclc_executor_message_array_destroy(executor, &executor->handles[i]);
+        executor->allocator->deallocate(
+          (void *) executor->handles[i].data_ring_snapshot, executor->allocator->state);
+      }
+    }
+    executor->allocator->deallocate(executor->handles, executor->allocator->state);
+    executor->handles = NULL;
+    executor->allocator->deallocate(
+      executor->wait_set_entities.entities,
+      executor->allocator->state);
+    executor->wait_set_entities.entities = NULL;
+    executor->allocator->deallocate(executor->dispatch_order, executor->allocator->state);
+    executor->dispatch_order = NULL;
+    executor->allocator->deallocate(executor->hot_handles, executor->allocator->state);
+    executor->hot_handles = NULL;
+    executor->allocator->deallocate(executor->ready_list, executor->allocator->state);
+    executor->ready_list = NULL;
+    executor->ready_list_size = 0;
+    executor->deferred_list = NULL;
+    executor->deferred_list_size = 0;
+    executor->carried_over_size = 0;
+    executor->deferred_runnable = false;
+    executor->ready_bitmap = NULL;
+    executor->ready_bitmap_words = 0;
+    if (NULL != executor->monitoring.trace) {
+      rcl_ret_t rc = rclc_executor_trace_fini(executor->monitoring.trace);
+      RCLC_UNUSED(rc);
+      executor->monitoring.trace = NULL;
+    }
+    executor->allocator->deallocate(executor->handle_map, executor->allocator->state);
+    executor->handle_map = NULL;
+    executor->handle_map_mask = 0;
+    executor->max_handles = 0;
+    executor->index = 0;
+    rclc_executor_handle_counters_zero_init(&executor->info);
+
+    // free memory of wait_set if it has been initialized
+    // calling it with un-initialized wait_set will fail.
+    if (rcl_wait_set_is_valid(&executor->wait_set)) {
+      rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_fini, rcl_wait_set_fini);
+      }
+    }
+    if (NULL != executor->timer_wheel) {
+      rcl_ret_t rc = rclc_executor_timer_wheel_fini(executor->timer_wheel);
+      RCLC_UNUSED(rc);
+      executor->timer_wheel = NULL;
+    }
+    executor->timeout_ns = DEFAULT_WAIT_TIMEOUT_NS;
+  } else {
+    // Repeated calls to fini or calling fini on a zero initialized executor is ok
+  }
+  return RCL_RET_OK;
+}
 
+
+rcl_ret_t
+rclc_executor_add_subscription(
+  rclc_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_t callback,
+  rclc_executor_handle_invocation_t invocation)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;     // TODO(jst3si) better name : rclc_RET_BUFFER_OVERFLOW
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_TIMER;
-  executor->handles[executor->index].timer = timer;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when timer elapsed
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msg;
+  executor->handles[executor->index].subscription_callback = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = NULL;
   executor->handles[executor->index].data_available = false;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_timer function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription.");
       return ret;
     }
   }
-  executor->info.number_of_timers++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a timer.");
+
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
   return ret;
 }
 
+
 rcl_ret_t
-rclc_executor_add_client(
+rclc_executor_add_subscription_with_context(
   rclc_executor_t * executor,
-  rcl_client_t * client,
-  void * response_msg,
-  rclc_client_callback_t callback)
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_CLIENT;
-  executor->handles[executor->index].client = client;
-  executor->handles[executor->index].data = response_msg;
-  executor->handles[executor->index].client_callback = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_WITH_CONTEXT;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msg;
+  executor->handles[executor->index].subscription_callback_with_context = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].callback_context = context;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_client function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_with_context.");
       return ret;
     }
   }
 
-  executor->info.number_of_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_client_with_request_id(
+rclc_executor_add_subscription_batch(
   rclc_executor_t * executor,
-  rcl_client_t * client,
-  void * response_msg,
-  rclc_client_callback_with_request_id_t callback)
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  size_t capacity,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_subscription_batch_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  if ((0 == msg_size) || (0 == capacity)) {
+    RCL_SET_ERROR_MSG("msg_size and capacity must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
+
+  void * msgs = _rclc_executor_message_array_create(executor, capacity, msg_size, init, fini);
+  if (NULL == msgs) {
+    RCL_SET_ERROR_MSG("Could not allocate messages in rclc_executor_add_subscription_batch.");
+    return RCL_RET_BAD_ALLOC;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_CLIENT_WITH_REQUEST_ID;
-  executor->handles[executor->index].client = client;
-  executor->handles[executor->index].data = response_msg;
-  executor->handles[executor->index].client_callback_with_reqid = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_BATCH;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msgs;
+  executor->handles[executor->index].data_msg_size = msg_size;
+  executor->handles[executor->index].data_capacity = capacity;
+  executor->handles[executor->index].data_count = 0;
+  executor->handles[executor->index].data_fini = fini;
+  executor->handles[executor->index].subscription_batch_callback = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].callback_context = context;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_client function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_batch.");
       return ret;
     }
   }
 
-  executor->info.number_of_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a batched subscription.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_service(
+rclc_executor_add_subscription_loaned(
   rclc_executor_t * executor,
-  rcl_service_t * service,
-  void * request_msg,
-  void * response_msg,
-  rclc_service_callback_t callback)
+  rcl_subscription_t * subscription,
+  void * msg,
+  rclc_subscription_callback_with_context_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(msg, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_SERVICE;
-  executor->handles[executor->index].service = service;
-  executor->handles[executor->index].data = request_msg;
-  // TODO(jst3si) new type with req and resp message in data field.
-  executor->handles[executor->index].data_response_msg = response_msg;
-  executor->handles[executor->index].service_callback = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_LOANED;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msg;
+  executor->handles[executor->index].data_loaned = NULL;
+  executor->handles[executor->index].subscription_callback_with_context = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].callback_context = context;
+  executor->handles[executor->index].data_available = false;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_loaned.");
       return ret;
     }
   }
 
-  executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a loaned subscription.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_service_with_context(
+rclc_executor_add_subscription_serialized(
   rclc_executor_t * executor,
-  rcl_service_t * service,
-  void * request_msg,
-  void * response_msg,
-  rclc_service_callback_with_context_t callback,
-  void * context)
-{
+  rcl_subscription_t * subscription,
+  size_t initial_capacity,
+  rclc_subscription_serialized_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
+{
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
+
+  rcl_serialized_message_t * msg =
+    _rclc_executor_serialized_message_create(executor, initial_capacity);
+  if (NULL == msg) {
+    RCL_SET_ERROR_MSG(
+      "Could not allocate serialized message in rclc_executor_add_subscription_serialized.");
+    return RCL_RET_BAD_ALLOC;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_SERVICE_WITH_CONTEXT;
-  executor->handles[executor->index].service = service;
-  executor->handles[executor->index].data = request_msg;
-  // TODO(jst3si) new type with req and resp message in data field.
-  executor->handles[executor->index].data_response_msg = response_msg;
-  executor->handles[executor->index].service_callback_with_context = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_SERIALIZED;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msg;
+  executor->handles[executor->index].subscription_serialized_callback = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = context;
+  executor->handles[executor->index].data_available = false;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_serialized.");
       return ret;
     }
   }
 
-  executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a serialized subscription.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_service_with_request_id(
+rclc_executor_add_subscription_ring(
   rclc_executor_t * executor,
-  rcl_service_t * service,
-  void * request_msg,
-  void * response_msg,
-  rclc_service_callback_with_request_id_t callback)
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  size_t depth,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_subscription_ring_callback_t callback,
+  void * context,
+  rclc_executor_handle_invocation_t invocation)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  if ((0 == msg_size) || (0 == depth)) {
+    RCL_SET_ERROR_MSG("msg_size and depth must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   rcl_ret_t ret = RCL_RET_OK;
   // array bound check
   if (executor->index >= executor->max_handles) {
-    rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
-    return ret;
+    return RCL_RET_ERROR;
+  }
+  if (_rclc_executor_handle_is_added(executor, subscription)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
+
+  void * msgs = _rclc_executor_message_array_create(executor, depth, msg_size, init, fini);
+  if (NULL == msgs) {
+    RCL_SET_ERROR_MSG("Could not allocate messages in rclc_executor_add_subscription_ring.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  const void ** snapshot = executor->allocator->zero_allocate(
+    depth, sizeof(void *), executor->allocator->state);
+  if (NULL == snapshot) {
+    for (size_t i = 0; (NULL != fini) && (i < depth); i++) {
+      fini((uint8_t *) msgs + i * msg_size);
+    }
+    executor->allocator->deallocate(msgs, executor->allocator->state);
+    RCL_SET_ERROR_MSG("Could not allocate snapshot in rclc_executor_add_subscription_ring.");
+    return RCL_RET_BAD_ALLOC;
   }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_SERVICE_WITH_REQUEST_ID;
-  executor->handles[executor->index].service = service;
-  executor->handles[executor->index].data = request_msg;
-  // TODO(jst3si) new type with req and resp message in data field.
-  executor->handles[executor->index].data_response_msg = response_msg;
-  executor->handles[executor->index].service_callback_with_reqid = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].type = RCLC_SUBSCRIPTION_RING;
+  executor->handles[executor->index].subscription = subscription;
+  executor->handles[executor->index].data = msgs;
+  executor->handles[executor->index].data_msg_size = msg_size;
+  executor->handles[executor->index].data_capacity = depth;
+  executor->handles[executor->index].data_count = 0;
+  executor->handles[executor->index].data_ring_head = 0;
+  executor->handles[executor->index].data_ring_size = 0;
+  executor->handles[executor->index].data_ring_snapshot = snapshot;
+  executor->handles[executor->index].data_fini = fini;
+  executor->handles[executor->index].subscription_ring_callback = callback;
+  executor->handles[executor->index].invocation = invocation;
   executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].callback_context = context;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_subscription_ring.");
       return ret;
     }
   }
 
-  executor->info.number_of_services++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  executor->info.number_of_subscriptions++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a subscription ring.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_guard_condition(
+rclc_executor_add_timer(
   rclc_executor_t * executor,
-  rcl_guard_condition_t * gc,
-  rclc_gc_callback_t callback)
+  rcl_timer_t * timer)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(gc, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+
   // array bound check
   if (executor->index >= executor->max_handles) {
-    ret = RCL_RET_ERROR;
+    rcl_ret_t ret = RCL_RET_ERROR;     // TODO(jst3si) better name : rclc_RET_BUFFER_OVERFLOW
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return ret;
   }
+  if (_rclc_executor_handle_is_added(executor, timer)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_GUARD_CONDITION;
-  executor->handles[executor->index].gc = gc;
-  executor->handles[executor->index].gc_callback = callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].type = RCLC_TIMER;
+  executor->handles[executor->index].timer = timer;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when timer elapsed
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = NULL;
+  executor->handles[executor->index].data_available = false;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_guard_condition function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_timer function.");
       return ret;
     }
   }
-
-  executor->info.number_of_guard_conditions++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a guard_condition.");
+  executor->info.number_of_timers++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a timer.");
   return ret;
 }
 
-static
 rcl_ret_t
-_rclc_executor_remove_handle(rclc_executor_t * executor, rclc_executor_handle_t * handle)
+rclc_executor_enable_timer_wheel(
+  rclc_executor_t * executor,
+  rcl_clock_t * clock,
+  const uint64_t tick_ns)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-
-  rcl_ret_t ret = RCL_RET_OK;
-
-  // NULL will be returned by _rclc_executor_find_handle if the handle is not found
-  if (NULL == handle) {
-    RCL_SET_ERROR_MSG("handle not found in rclc_executor_remove_handle");
-    return RCL_RET_ERROR;
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  if ((tick_ns == 0) || (tick_ns > (uint64_t) INT64_MAX)) {
+    RCL_SET_ERROR_MSG("tick of timer wheel must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
   }
-
-  if ((handle >= &executor->handles[executor->index]) ||
-    (handle < executor->handles))
-  {
-    RCL_SET_ERROR_MSG("Handle out of bounds");
+  if (NULL != executor->timer_wheel) {
+    RCL_SET_ERROR_MSG("timer wheel is already enabled");
     return RCL_RET_ERROR;
   }
-  if (0 == executor->index) {
-    RCL_SET_ERROR_MSG("No handles to remove");
+  if (executor->index >= executor->max_handles) {
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return RCL_RET_ERROR;
   }
 
-  // shorten the list of handles without changing the order of remaining handles
-  executor->index--;
-  for (rclc_executor_handle_t * handle_dest = handle;
-    handle_dest < &executor->handles[executor->index];
-    handle_dest++)
-  {
-    *handle_dest = *(handle_dest + 1);
+  rclc_executor_timer_wheel_t * wheel = NULL;
+  rcl_ret_t ret = rclc_executor_timer_wheel_init(
+    &wheel, executor->context, clock, (int64_t) tick_ns, executor->allocator);
+  if (ret != RCL_RET_OK) {
+    return ret;
   }
-  ret = rclc_executor_handle_init(&executor->handles[executor->index], executor->max_handles);
-
-  // force a refresh of the wait set
-  if (rcl_wait_set_is_valid(&executor->wait_set)) {
-    ret = rcl_wait_set_fini(&executor->wait_set);
-    if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in _rclc_executor_remove_handle.");
-      return ret;
-    }
+  ret = rclc_executor_add_timer(executor, &wheel->timer);
+  if (ret != RCL_RET_OK) {
+    rcl_ret_t rc = rclc_executor_timer_wheel_fini(wheel);
+    RCLC_UNUSED(rc);
+    return ret;
   }
-
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a handle.");
+  executor->timer_wheel = wheel;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Enabled the timer wheel.");
   return ret;
 }
 
-static
-rclc_executor_handle_t *
-_rclc_executor_find_handle(
-  rclc_executor_t * executor,
-  const void * rcl_handle)
-{
-  for (rclc_executor_handle_t * test_handle = executor->handles;
-    test_handle < &executor->handles[executor->index];
-    test_handle++)
-  {
-    if (rcl_handle == rclc_executor_handle_get_ptr(test_handle)) {
-      return test_handle;
-    }
-  }
-  return NULL;
-}
-
-
 rcl_ret_t
-rclc_executor_remove_subscription(
+rclc_executor_start_wheel_timer(
   rclc_executor_t * executor,
-  const rcl_subscription_t * subscription)
+  rclc_wheel_timer_t * timer)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t ret = RCL_RET_OK;
-
-  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, subscription);
-  ret = _rclc_executor_remove_handle(executor, handle);
-  if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_subscription.");
-    return ret;
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  if (NULL == executor->timer_wheel) {
+    RCL_SET_ERROR_MSG("timer wheel is not enabled");
+    return RCL_RET_ERROR;
   }
-  executor->info.number_of_subscriptions--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a subscription.");
-  return ret;
+  return rclc_executor_timer_wheel_start(executor->timer_wheel, timer);
 }
 
 rcl_ret_t
-rclc_executor_remove_timer(
+rclc_executor_cancel_wheel_timer(
   rclc_executor_t * executor,
-  const rcl_timer_t * timer)
+  rclc_wheel_timer_t * timer)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t ret = RCL_RET_OK;
-
-  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, timer);
-  ret = _rclc_executor_remove_handle(executor, handle);
-  if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_timer.");
-    return ret;
+  if (NULL == executor->timer_wheel) {
+    RCL_SET_ERROR_MSG("timer wheel is not enabled");
+    return RCL_RET_ERROR;
   }
-  executor->info.number_of_timers--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a timer.");
-  return ret;
+  rclc_executor_timer_wheel_cancel(executor->timer_wheel, timer);
+  return RCL_RET_OK;
 }
 
 rcl_ret_t
-rclc_executor_remove_client(
+rclc_executor_add_client(
   rclc_executor_t * executor,
-  const rcl_client_t * client)
+  rcl_client_t * client,
+  void * response_msg,
+  rclc_client_callback_t callback)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-
-  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, client);
-  ret = _rclc_executor_remove_handle(executor, handle);
-  if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_client.");
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return ret;
   }
-  executor->info.number_of_clients--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a client.");
-  return ret;
-}
+  if (_rclc_executor_handle_is_added(executor, client)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
 
-rcl_ret_t
-rclc_executor_remove_service(
-  rclc_executor_t * executor,
-  const rcl_service_t * service)
-{
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t ret = RCL_RET_OK;
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_CLIENT;
+  executor->handles[executor->index].client = client;
+  executor->handles[executor->index].data = response_msg;
+  executor->handles[executor->index].client_callback = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = NULL;
 
-  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, service);
-  ret = _rclc_executor_remove_handle(executor, handle);
-  if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_service.");
-    return ret;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_client function.");
+      return ret;
+    }
   }
-  executor->info.number_of_services--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a service.");
+
+  executor->info.number_of_clients++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
   return ret;
 }
 
-
 rcl_ret_t
-rclc_executor_remove_guard_condition(
+rclc_executor_add_client_with_request_id(
   rclc_executor_t * executor,
-  const rcl_guard_condition_t * guard_condition)
+  rcl_client_t * client,
+  void * response_msg,
+  rclc_client_callback_with_request_id_t callback)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-
-  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, guard_condition);
-  ret = _rclc_executor_remove_handle(executor, handle);
-  if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_guard_condition.");
-    return ret;
-  }
-  executor->info.number_of_guard_conditions--;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a guard condition.");
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+  if (_rclc_executor_handle_is_added(executor, client)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
+
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_CLIENT_WITH_REQUEST_ID;
+  executor->handles[executor->index].client = client;
+  executor->handles[executor->index].data = response_msg;
+  executor->handles[executor->index].client_callback_with_reqid = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = NULL;
+
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_client function.");
+      return ret;
+    }
+  }
+
+  executor->info.number_of_clients++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a client.");
   return ret;
 }
 
 rcl_ret_t
-rclc_executor_add_action_client(
+rclc_executor_add_service(
   rclc_executor_t * executor,
-  rclc_action_client_t * action_client,
-  size_t handles_number,
-  void * ros_result_response,
-  void * ros_feedback,
-  rclc_action_client_goal_callback_t goal_callback,
-  rclc_action_client_feedback_callback_t feedback_callback,
-  rclc_action_client_result_callback_t result_callback,
-  rclc_action_client_cancel_callback_t cancel_callback,
-  void * context)
+  rcl_service_t * service,
+  void * request_msg,
+  void * response_msg,
+  rclc_service_callback_t callback)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(action_client, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(result_callback, RCL_RET_INVALID_ARGUMENT);
-
-  if (NULL != feedback_callback) {
-    RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
-  }
-
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-
   // array bound check
   if (executor->index >= executor->max_handles) {
     rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return ret;
   }
-
-  action_client->allocator = executor->allocator;
-
-  // Init goal handles
-  action_client->goal_handles_memory =
-    executor->allocator->allocate(
-    handles_number * sizeof(rclc_action_goal_handle_t),
-    executor->allocator->state);
-  if (NULL == action_client->goal_handles_memory) {
+  if (_rclc_executor_handle_is_added(executor, service)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
     return RCL_RET_ERROR;
   }
-  action_client->goal_handles_memory_size = handles_number;
-  rclc_action_init_goal_handle_memory(action_client);
-
-  action_client->ros_feedback = ros_feedback;
-  action_client->ros_result_response = ros_result_response;
-
-  action_client->ros_cancel_response.goals_canceling.data =
-    (action_msgs__msg__GoalInfo *) executor->allocator->allocate(
-    handles_number *
-    sizeof(action_msgs__msg__GoalInfo), executor->allocator->state);
-  action_client->ros_cancel_response.goals_canceling.size = 0;
-  action_client->ros_cancel_response.goals_canceling.capacity = handles_number;
-
-  rclc_action_goal_handle_t * goal_handle = action_client->free_goal_handles;
-  while (NULL != goal_handle) {
-    goal_handle->action_client = action_client;
-    goal_handle = goal_handle->next;
-  }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_ACTION_CLIENT;
-  executor->handles[executor->index].action_client = action_client;
-  executor->handles[executor->index].action_client->goal_callback = goal_callback;
-  executor->handles[executor->index].action_client->feedback_callback = feedback_callback;
-  executor->handles[executor->index].action_client->result_callback = result_callback;
-  executor->handles[executor->index].action_client->cancel_callback = cancel_callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].type = RCLC_SERVICE;
+  executor->handles[executor->index].service = service;
+  executor->handles[executor->index].data = request_msg;
+  // TODO(jst3si) new type with req and resp message in data field.
+  executor->handles[executor->index].data_response_msg = response_msg;
+  executor->handles[executor->index].service_callback = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
   executor->handles[executor->index].initialized = true;
-  executor->handles[executor->index].callback_context = context;
-
-  executor->handles[executor->index].action_client->feedback_available = false;
-  executor->handles[executor->index].action_client->status_available = false;
-  executor->handles[executor->index].action_client->goal_response_available = false;
-  executor->handles[executor->index].action_client->result_response_available = false;
-  executor->handles[executor->index].action_client->cancel_response_available = false;
+  executor->handles[executor->index].callback_context = NULL;
 
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_action_client function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
       return ret;
     }
   }
 
-  size_t num_subscriptions = 0, num_guard_conditions = 0,
-    num_timers = 0, num_clients = 0, num_services = 0;
-
-  ret = rcl_action_client_wait_set_get_num_entities(
-    &action_client->rcl_handle,
-    &num_subscriptions,
-    &num_guard_conditions,
-    &num_timers,
-    &num_clients,
-    &num_services);
-
-  executor->info.number_of_subscriptions += num_subscriptions;
-  executor->info.number_of_guard_conditions += num_guard_conditions;
-  executor->info.number_of_timers += num_timers;
-  executor->info.number_of_clients += num_clients;
-  executor->info.number_of_services += num_services;
-
-  executor->info.number_of_action_clients++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added an action client.");
+  executor->info.number_of_services++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
   return ret;
 }
 
-
 rcl_ret_t
-rclc_executor_add_action_server(
+rclc_executor_add_service_with_context(
   rclc_executor_t * executor,
-  rclc_action_server_t * action_server,
-  size_t handles_number,
-  void * ros_goal_request,
-  size_t ros_goal_request_size,
-  rclc_action_server_handle_goal_callback_t goal_callback,
-  rclc_action_server_handle_cancel_callback_t cancel_callback,
+  rcl_service_t * service,
+  void * request_msg,
+  void * response_msg,
+  rclc_service_callback_with_context_t callback,
   void * context)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(action_server, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_goal_request, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_callback, RCL_RET_INVALID_ARGUMENT);
-
-  if (ros_goal_request_size <= 0) {
-    return RCL_RET_ERROR;
-  }
-
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-
-  action_server->allocator = executor->allocator;
-
   // array bound check
   if (executor->index >= executor->max_handles) {
     rcl_ret_t ret = RCL_RET_ERROR;
     RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
     return ret;
   }
-
-  // Init goal handles
-  action_server->goal_handles_memory =
-    executor->allocator->allocate(
-    handles_number * sizeof(rclc_action_goal_handle_t),
-    executor->allocator->state);
-  if (NULL == action_server->goal_handles_memory) {
+  if (_rclc_executor_handle_is_added(executor, service)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
     return RCL_RET_ERROR;
   }
-  action_server->goal_handles_memory_size = handles_number;
-  rclc_action_init_goal_handle_memory(action_server);
-
-  rclc_action_goal_handle_t * goal_handle = action_server->free_goal_handles;
-  size_t ros_goal_request_index = 0;
-  while (NULL != goal_handle) {
-    goal_handle->ros_goal_request =
-      (void *) &((uint8_t *)ros_goal_request)[ros_goal_request_index * ros_goal_request_size]; // NOLINT()
-    goal_handle->action_server = action_server;
-    ros_goal_request_index++;
-    goal_handle = goal_handle->next;
-  }
 
   // assign data fields
-  executor->handles[executor->index].type = RCLC_ACTION_SERVER;
-  executor->handles[executor->index].action_server = action_server;
-  executor->handles[executor->index].action_server->goal_callback = goal_callback;
-  executor->handles[executor->index].action_server->cancel_callback = cancel_callback;
-  executor->handles[executor->index].invocation = ON_NEW_DATA;
+  executor->handles[executor->index].type = RCLC_SERVICE_WITH_CONTEXT;
+  executor->handles[executor->index].service = service;
+  executor->handles[executor->index].data = request_msg;
+  // TODO(jst3si) new type with req and resp message in data field.
+  executor->handles[executor->index].data_response_msg = response_msg;
+  executor->handles[executor->index].service_callback_with_context = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
   executor->handles[executor->index].initialized = true;
   executor->handles[executor->index].callback_context = context;
 
-  executor->handles[executor->index].action_server->goal_ended = false;
-  executor->handles[executor->index].action_server->goal_request_available = false;
-  executor->handles[executor->index].action_server->cancel_request_available = false;
-  executor->handles[executor->index].action_server->result_request_available = false;
-  executor->handles[executor->index].action_server->goal_expired_available = false;
-
-  // increase index of handle array
-  executor->index++;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
   // invalidate wait_set so that in next spin_some() call the
   // 'executor->wait_set' is updated accordingly
   if (rcl_wait_set_is_valid(&executor->wait_set)) {
     ret = rcl_wait_set_fini(&executor->wait_set);
     if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_action_server function.");
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
       return ret;
     }
   }
 
-  size_t num_subscriptions = 0, num_guard_conditions = 0,
-    num_timers = 0, num_clients = 0, num_services = 0;
-
-  ret = rcl_action_server_wait_set_get_num_entities(
-    &action_server->rcl_handle,
-    &num_subscriptions,
-    &num_guard_conditions,
-    &num_timers,
-    &num_clients,
-    &num_services);
-
-  executor->info.number_of_subscriptions += num_subscriptions;
-  executor->info.number_of_guard_conditions += num_guard_conditions;
-  executor->info.number_of_timers += num_timers;
-  executor->info.number_of_clients += num_clients;
-  executor->info.number_of_services += num_services;
-
-  executor->info.number_of_action_servers++;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a action client.");
+  executor->info.number_of_services++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
   return ret;
 }
 
-/***
- * operates on handle executor->handles[i]
- * - evaluates the status bit in the wait_set for this handle
- * - if new message is available or timer is ready, assigns executor->handles[i].data_available = true
- */
-
-// todo refactor parameters: (rclc_executor_handle_t *, rcl_wait_set_t * wait_set)
-
-static
 rcl_ret_t
-_rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+rclc_executor_add_service_with_request_id(
+  rclc_executor_t * executor,
+  rcl_service_t * service,
+  void * request_msg,
+  void * response_msg,
+  rclc_service_callback_with_request_id_t callback)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t rc = RCL_RET_OK;
-
-  switch (handle->type) {
-    case RCLC_SUBSCRIPTION:
-    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
-      handle->data_available = (NULL != wait_set->subscriptions[handle->index]);
-      break;
-
-    case RCLC_TIMER:
-      // case RCLC_TIMER_WITH_CONTEXT:
-      handle->data_available = (NULL != wait_set->timers[handle->index]);
-      break;
-
-    case RCLC_SERVICE:
-    case RCLC_SERVICE_WITH_REQUEST_ID:
-    case RCLC_SERVICE_WITH_CONTEXT:
-      handle->data_available = (NULL != wait_set->services[handle->index]);
-      break;
-
-    case RCLC_CLIENT:
-    case RCLC_CLIENT_WITH_REQUEST_ID:
-      // case RCLC_CLIENT_WITH_CONTEXT:
-      handle->data_available = (NULL != wait_set->clients[handle->index]);
-      break;
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_msg, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+  if (_rclc_executor_handle_is_added(executor, service)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
 
-    case RCLC_GUARD_CONDITION:
-      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
-      handle->data_available = (NULL != wait_set->guard_conditions[handle->index]);
-      break;
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_SERVICE_WITH_REQUEST_ID;
+  executor->handles[executor->index].service = service;
+  executor->handles[executor->index].data = request_msg;
+  // TODO(jst3si) new type with req and resp message in data field.
+  executor->handles[executor->index].data_response_msg = response_msg;
+  executor->handles[executor->index].service_callback_with_reqid = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = NULL;
 
-    case RCLC_ACTION_CLIENT:
-      rc = rcl_action_client_wait_set_get_entities_ready(
-        wait_set,
-        &handle->action_client->rcl_handle,
-        &handle->action_client->feedback_available,
-        &handle->action_client->status_available,
-        &handle->action_client->goal_response_available,
-        &handle->action_client->cancel_response_available,
-        &handle->action_client->result_response_available
-      );
-      break;
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
 
-    case RCLC_ACTION_SERVER:
-      rc = rcl_action_server_wait_set_get_entities_ready(
-        wait_set,
-        &handle->action_server->rcl_handle,
-        &handle->action_server->goal_request_available,
-        &handle->action_server->cancel_request_available,
-        &handle->action_server->result_request_available,
-        &handle->action_server->goal_expired_available
-      );
-      break;
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_service function.");
+      return ret;
+    }
+  }
 
-    default:
-      RCUTILS_LOG_DEBUG_NAMED(
-        ROS_PACKAGE_NAME, "Error in _rclc_check_for_new_data:wait_set unknwon handle type: %d",
-        handle->type);
-      return RCL_RET_ERROR;
-  }    // switch-case
-  return rc;
+  executor->info.number_of_services++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a service.");
+  return ret;
 }
 
-// call rcl_take for subscription
-// todo change function signature (rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+rcl_ret_t
+rclc_executor_add_guard_condition(
+  rclc_executor_t * executor,
+  rcl_guard_condition_t * gc,
+  rclc_gc_callback_t callback)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(gc, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+  if (_rclc_executor_handle_is_added(executor, gc)) {
+    RCL_SET_ERROR_MSG("Handle has already been added to the executor.");
+    return RCL_RET_ERROR;
+  }
+
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_GUARD_CONDITION;
+  executor->handles[executor->index].gc = gc;
+  executor->handles[executor->index].gc_callback = callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // invoce when request came in
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = NULL;
+
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_guard_condition function.");
+      return ret;
+    }
+  }
+
+  executor->info.number_of_guard_conditions++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a guard_condition.");
+  return ret;
+}
 
 static
 rcl_ret_t
-_rclc_take_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+_rclc_executor_remove_handle(rclc_executor_t * executor, rclc_executor_handle_t * handle)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t rc = RCL_RET_OK;
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
 
-  switch (handle->type) {
-    case RCLC_SUBSCRIPTION:
-    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
-      if (wait_set->subscriptions[handle->index]) {
-        rmw_message_info_t messageInfo;
-        rc = rcl_take(
-          handle->subscription, handle->data, &messageInfo,
-          NULL);
-        if (rc != RCL_RET_OK) {
-          // rcl_take might return this error even with successfull rcl_wait
-          if (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
-            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
-            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          }
-          // invalidate that data is available, because rcl_take failed
-          if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
-            handle->data_available = false;
-          }
-          return rc;
-        }
-      }
-      break;
+  rcl_ret_t ret = RCL_RET_OK;
 
-    case RCLC_TIMER:
-      // case RCLC_TIMER_WITH_CONTEXT:
-      // nothing to do
-      // notification, that timer is ready already done in _rclc_evaluate_data_availability()
-      break;
+  // NULL will be returned by _rclc_executor_find_handle if the handle is not found
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_remove_handle");
+    return RCL_RET_ERROR;
+  }
 
-    case RCLC_ACTION_CLIENT:
-      if (handle->action_client->goal_response_available) {
-        Generic_SendGoal_Response aux_goal_response;
-        rmw_request_id_t aux_goal_response_header;
-        rc = rcl_action_take_goal_response(
-          &handle->action_client->rcl_handle,
-          &aux_goal_response_header,
-          &aux_goal_response);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_goal_response);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle =
-          rclc_action_find_handle_by_goal_request_sequence_number(
-          handle->action_client, aux_goal_response_header.sequence_number);
-        if (NULL != goal_handle) {
-          goal_handle->available_goal_response = true;
-          goal_handle->goal_accepted = aux_goal_response.accepted;
-        }
-      }
-      if (handle->action_client->feedback_callback != NULL &&
-        handle->action_client->feedback_available)
-      {
-        rc = rcl_action_take_feedback(
-          &handle->action_client->rcl_handle,
-          handle->action_client->ros_feedback);
+  if ((handle >= &executor->handles[executor->index]) ||
+    (handle < executor->handles))
+  {
+    RCL_SET_ERROR_MSG("Handle out of bounds");
+    return RCL_RET_ERROR;
+  }
+  if (0 == executor->index) {
+    RCL_SET_ERROR_MSG("No handles to remove");
+    return RCL_RET_ERROR;
+  }
 
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_feedback);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
-          handle->action_client,
-          &handle->action_client->ros_feedback->goal_id);
-        if (NULL != goal_handle) {
-          goal_handle->available_feedback = true;
-        }
-      }
-      if (handle->action_client->cancel_response_available) {
-        rmw_request_id_t cancel_response_header;
-        rc = rcl_action_take_cancel_response(
-          &handle->action_client->rcl_handle,
-          &cancel_response_header,
-          &handle->action_client->ros_cancel_response);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_cancel_response);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle =
-          rclc_action_find_handle_by_cancel_request_sequence_number(
-          handle->action_client,
-          cancel_response_header.sequence_number);
-        if (NULL != goal_handle) {
-          goal_handle->available_cancel_response = true;
-          goal_handle->goal_cancelled = false;
-          for (size_t i = 0; i < handle->action_client->ros_cancel_response.goals_canceling.size;
-            i++)
-          {
-            rclc_action_goal_handle_t * aux = rclc_action_find_goal_handle_by_uuid(
-              handle->action_client,
-              &handle->action_client->ros_cancel_response.goals_canceling.data[i].goal_id);
-            if (NULL != aux) {
-              goal_handle->goal_cancelled = true;
-            }
-          }
-        }
-      }
-      if (handle->action_client->result_response_available) {
-        rmw_request_id_t result_request_header;
-        rc = rcl_action_take_result_response(
-          &handle->action_client->rcl_handle,
-          &result_request_header,
-          handle->action_client->ros_result_response);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_result_response);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle =
-          rclc_action_find_handle_by_result_request_sequence_number(
-          handle->action_client, result_request_header.sequence_number);
-        if (NULL != goal_handle) {
-          goal_handle->available_result_response = true;
+  // handles are moved in memory: wait until no callback is executed by a worker thread
+  _rclc_executor_wait_for_workers(executor);
+
+  // return a loaned message, which has not been processed. If the loan cannot be returned,
+  // the handle is not removed.
+  ret = _rclc_executor_return_pending_loan(handle);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+
+  // free message array of a batched subscription
+  if (handle->type == RCLC_SUBSCRIPTION_BATCH) {
+    _rclc_executor_message_array_destroy(executor, handle);
+  }
+
+  // free buffer of a serialized subscription
+  if (handle->type == RCLC_SUBSCRIPTION_SERIALIZED) {
+    _rclc_executor_serialized_message_destroy(executor, handle->data);
+    handle->data = NULL;
+  }
+
+  // free message ring of a subscription ring
+  if (handle->type == RCLC_SUBSCRIPTION_RING) {
+    _rclc_executor_message_array_destroy(executor, handle);
+    executor->allocator->deallocate(
+      (void *) handle->data_ring_snapshot, executor->allocator->state);
+    handle->data_ring_snapshot = NULL;
+  }
+
+  // remove handle from the hash table
+  size_t pos = _rclc_executor_handle_map_find(executor, rclc_executor_handle_get_ptr(handle));
+  if (pos != RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    _rclc_executor_handle_map_erase(executor, pos);
+  }
+
+  // move the last handle into the free slot. The processing order is given by
+  // the registration number of the handles, not by their position in the array.
+  executor->index--;
+  rclc_executor_handle_t * last_handle = &executor->handles[executor->index];
+  if (handle != last_handle) {
+    pos = _rclc_executor_handle_map_find(executor, rclc_executor_handle_get_ptr(last_handle));
+    *handle = *last_handle;
+    if (pos != RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+      executor->handle_map[pos] = (size_t) (handle - executor->handles);
+    }
+  }
+  ret = rclc_executor_handle_init(last_handle, executor->max_handles);
+
+  // the wait_set keeps its size, only the order of the rcl-handles in the wait_set
+  // and the processing order of the handles are updated in the next spin
+  executor->wait_set_entities_is_valid = false;
+  executor->dispatch_order_is_valid = false;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a handle.");
+  return ret;
+}
+
+static
+rclc_executor_handle_t *
+_rclc_executor_find_handle(
+  rclc_executor_t * executor,
+  const void * rcl_handle)
+{
+  size_t pos = _rclc_executor_handle_map_find(executor, rcl_handle);
+  if (pos == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    return NULL;
+  }
+  return &executor->handles[executor->handle_map[pos]];
+}
+
+rclc_executor_handle_t *
+rclc_executor_find_handle(
+  rclc_executor_t * executor,
+  const void * rcl_handle)
+{
+  if ((NULL == executor) || (NULL == executor->handle_map)) {
+    return NULL;
+  }
+  return _rclc_executor_find_handle(executor, rcl_handle);
+}
+
+rcl_ret_t
+rclc_executor_remove_subscription(
+  rclc_executor_t * executor,
+  const rcl_subscription_t * subscription)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, subscription);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_subscription.");
+    return ret;
+  }
+  executor->info.number_of_subscriptions--;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a subscription.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_remove_timer(
+  rclc_executor_t * executor,
+  const rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, timer);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_timer.");
+    return ret;
+  }
+  executor->info.number_of_timers--;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a timer.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_remove_client(
+  rclc_executor_t * executor,
+  const rcl_client_t * client)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, client);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_client.");
+    return ret;
+  }
+  executor->info.number_of_clients--;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a client.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_remove_service(
+  rclc_executor_t * executor,
+  const rcl_service_t * service)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, service);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_service.");
+    return ret;
+  }
+  executor->info.number_of_services--;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a service.");
+  return ret;
+}
+
+
+rcl_ret_t
+rclc_executor_remove_guard_condition(
+  rclc_executor_t * executor,
+  const rcl_guard_condition_t * guard_condition)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, guard_condition);
+  ret = _rclc_executor_remove_handle(executor, handle);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Failed to remove handle in rclc_executor_remove_guard_condition.");
+    return ret;
+  }
+  executor->info.number_of_guard_conditions--;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Removed a guard condition.");
+  return ret;
+}
+
+rcl_ret_t
+rclc_executor_set_subscription_max_takes(
+  rclc_executor_t * executor,
+  const rcl_subscription_t * subscription,
+  size_t max_takes_per_spin)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, subscription);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("subscription not found in rclc_executor_set_subscription_max_takes");
+    return RCL_RET_ERROR;
+  }
+  handle->max_takes_per_spin = max_takes_per_spin;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_handle_priority(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  int priority)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, rcl_handle);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_set_handle_priority");
+    return RCL_RET_ERROR;
+  }
+  handle->priority = priority;
+  executor->dispatch_order_is_valid = false;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_handle_deadline(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  rcutils_duration_value_t deadline)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+  if (deadline < 0) {
+    RCL_SET_ERROR_MSG("deadline must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, rcl_handle);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_set_handle_deadline");
+    return RCL_RET_ERROR;
+  }
+  handle->deadline = deadline;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_handle_wcet(
+  rclc_executor_t * executor,
+  const void * rcl_handle,
+  uint64_t wcet_ns)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+
+  rclc_executor_handle_t * handle = _rclc_executor_find_handle(executor, rcl_handle);
+  if (NULL == handle) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_set_handle_wcet");
+    return RCL_RET_ERROR;
+  }
+  _rclc_executor_wait_for_workers(executor);
+  handle->wcet_ns = wcet_ns;
+  handle->wcet_overruns = 0;
+  handle->wcet_worst_ns = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_set_overrun_callback(
+  rclc_executor_t * executor,
+  rclc_executor_overrun_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  _rclc_executor_wait_for_workers(executor);
+  executor->monitoring.overrun_callback = callback;
+  executor->monitoring.overrun_context = context;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_get_handle_wcet_overruns(
+  const rclc_executor_t * executor,
+  const void * rcl_handle,
+  uint64_t * overruns,
+  uint64_t * worst_ns)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(overruns, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(worst_ns, RCL_RET_INVALID_ARGUMENT);
+
+  size_t pos = _rclc_executor_handle_map_find(executor, rcl_handle);
+  if (pos == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_get_handle_wcet_overruns");
+    return RCL_RET_ERROR;
+  }
+  // the overrun counters of a handle are written by the worker thread, which executes its
+  // callback
+  _rclc_executor_wait_for_workers(executor);
+  const rclc_executor_handle_t * handle = &executor->handles[executor->handle_map[pos]];
+  *overruns = handle->wcet_overruns;
+  *worst_ns = handle->wcet_worst_ns;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_enable_statistics(
+  rclc_executor_t * executor,
+  bool enable)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  _rclc_executor_wait_for_workers(executor);
+  executor->monitoring.statistics_enabled = enable;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_get_handle_statistics(
+  const rclc_executor_t * executor,
+  const void * rcl_handle,
+  rclc_executor_handle_statistics_t * statistics)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+
+  size_t pos = _rclc_executor_handle_map_find(executor, rcl_handle);
+  if (pos == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+    RCL_SET_ERROR_MSG("handle not found in rclc_executor_get_handle_statistics");
+    return RCL_RET_ERROR;
+  }
+  // the statistics of a handle are written by the worker thread, which executes its callback
+  _rclc_executor_wait_for_workers(executor);
+  *statistics = executor->handles[executor->handle_map[pos]].statistics;
+  if (statistics->invocations > 0) {
+    statistics->callback_time_mean_ns =
+      statistics->callback_time_total_ns / statistics->invocations;
+  } else {
+    // no callback recorded yet
+    statistics->callback_time_min_ns = 0;
+    statistics->callback_time_mean_ns = 0;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_get_spin_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_spin_statistics_t * statistics)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  *statistics = executor->spin_statistics;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_reset_statistics(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  _rclc_executor_wait_for_workers(executor);
+  memset(&executor->spin_statistics, 0, sizeof(rclc_executor_spin_statistics_t));
+  memset(&executor->period_statistics, 0, sizeof(rclc_executor_period_statistics_t));
+  memset(&executor->busy_poll_statistics, 0, sizeof(rclc_executor_busy_poll_statistics_t));
+  memset(&executor->budget_statistics, 0, sizeof(rclc_executor_budget_statistics_t));
+  for (size_t i = 0; i < executor->index; i++) {
+    rclc_executor_handle_statistics_reset(&executor->handles[i].statistics);
+    executor->handles[i].wcet_overruns = 0;
+    executor->handles[i].wcet_worst_ns = 0;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_enable_trace(
+  rclc_executor_t * executor,
+  size_t capacity)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_trace_t * trace = NULL;
+  rcl_ret_t rc = rclc_executor_trace_init(&trace, capacity, executor->allocator);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  rc = rclc_executor_disable_trace(executor);
+  executor->monitoring.trace = trace;
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_disable_trace(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+  // worker threads may still record the end of a callback into the trace
+  _rclc_executor_wait_for_workers(executor);
+  if (NULL != executor->monitoring.trace) {
+    rc = rclc_executor_trace_fini(executor->monitoring.trace);
+    executor->monitoring.trace = NULL;
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_dump_trace(
+  const rclc_executor_t * executor,
+  const char * path)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(path, RCL_RET_INVALID_ARGUMENT);
+  if (NULL == executor->monitoring.trace) {
+    RCL_SET_ERROR_MSG("tracing is not enabled");
+    return RCL_RET_ERROR;
+  }
+  return rclc_executor_trace_dump(executor->monitoring.trace, path);
+}
+
+/***
+ * records the time spent in rcl_wait (from wait_start to wait_end) and the time spent in
+ * taking data and dispatching callbacks (from wait_end until now) of one spin.
+ */
+static
+void
+_rclc_executor_record_spin_statistics(
+  rclc_executor_t * executor,
+  rcutils_time_point_value_t wait_start,
+  rcutils_time_point_value_t wait_end)
+{
+  rcutils_time_point_value_t now;
+  if (rcutils_steady_time_now(&now) != RCUTILS_RET_OK) {
+    return;
+  }
+  rclc_executor_spin_statistics_t * statistics = &executor->spin_statistics;
+  uint64_t wait_time = (uint64_t) (wait_end - wait_start);
+  uint64_t dispatch_time = (uint64_t) (now - wait_end);
+  statistics->spins++;
+  statistics->wait_time_total_ns += wait_time;
+  if (wait_time > statistics->wait_time_max_ns) {
+    statistics->wait_time_max_ns = wait_time;
+  }
+  statistics->dispatch_time_total_ns += dispatch_time;
+  if (dispatch_time > statistics->dispatch_time_max_ns) {
+    statistics->dispatch_time_max_ns = dispatch_time;
+  }
+}
+
+rcl_ret_t
+rclc_executor_add_action_client(
+  rclc_executor_t * executor,
+  rclc_action_client_t * action_client,
+  size_t handles_number,
+  void * ros_result_response,
+  void * ros_feedback,
+  rclc_action_client_goal_callback_t goal_callback,
+  rclc_action_client_feedback_callback_t feedback_callback,
+  rclc_action_client_result_callback_t result_callback,
+  rclc_action_client_cancel_callback_t cancel_callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(result_callback, RCL_RET_INVALID_ARGUMENT);
+
+  if (NULL != feedback_callback) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+
+  action_client->allocator = executor->allocator;
+
+  // Init goal handles
+  action_client->goal_handles_memory =
+    executor->allocator->allocate(
+    handles_number * sizeof(rclc_action_goal_handle_t),
+    executor->allocator->state);
+  if (NULL == action_client->goal_handles_memory) {
+    return RCL_RET_ERROR;
+  }
+  action_client->goal_handles_memory_size = handles_number;
+  rclc_action_init_goal_handle_memory(action_client);
+
+  action_client->ros_feedback = ros_feedback;
+  action_client->ros_result_response = ros_result_response;
+
+  action_client->ros_cancel_response.goals_canceling.data =
+    (action_msgs__msg__GoalInfo *) executor->allocator->allocate(
+    handles_number *
+    sizeof(action_msgs__msg__GoalInfo), executor->allocator->state);
+  action_client->ros_cancel_response.goals_canceling.size = 0;
+  action_client->ros_cancel_response.goals_canceling.capacity = handles_number;
+
+  rclc_action_goal_handle_t * goal_handle = action_client->free_goal_handles;
+  while (NULL != goal_handle) {
+    goal_handle->action_client = action_client;
+    goal_handle = goal_handle->next;
+  }
+
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_ACTION_CLIENT;
+  executor->handles[executor->index].action_client = action_client;
+  executor->handles[executor->index].action_client->goal_callback = goal_callback;
+  executor->handles[executor->index].action_client->feedback_callback = feedback_callback;
+  executor->handles[executor->index].action_client->result_callback = result_callback;
+  executor->handles[executor->index].action_client->cancel_callback = cancel_callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;  // i.e. when request came in
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = context;
+
+  executor->handles[executor->index].action_client->feedback_available = false;
+  executor->handles[executor->index].action_client->status_available = false;
+  executor->handles[executor->index].action_client->goal_response_available = false;
+  executor->handles[executor->index].action_client->result_response_available = false;
+  executor->handles[executor->index].action_client->cancel_response_available = false;
+
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_action_client function.");
+      return ret;
+    }
+  }
+
+  size_t num_subscriptions = 0, num_guard_conditions = 0,
+    num_timers = 0, num_clients = 0, num_services = 0;
+
+  ret = rcl_action_client_wait_set_get_num_entities(
+    &action_client->rcl_handle,
+    &num_subscriptions,
+    &num_guard_conditions,
+    &num_timers,
+    &num_clients,
+    &num_services);
+
+  executor->info.number_of_subscriptions += num_subscriptions;
+  executor->info.number_of_guard_conditions += num_guard_conditions;
+  executor->info.number_of_timers += num_timers;
+  executor->info.number_of_clients += num_clients;
+  executor->info.number_of_services += num_services;
+
+  executor->info.number_of_action_clients++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added an action client.");
+  return ret;
+}
+
+
+rcl_ret_t
+rclc_executor_add_action_server(
+  rclc_executor_t * executor,
+  rclc_action_server_t * action_server,
+  size_t handles_number,
+  void * ros_goal_request,
+  size_t ros_goal_request_size,
+  rclc_action_server_handle_goal_callback_t goal_callback,
+  rclc_action_server_handle_cancel_callback_t cancel_callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_server, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_goal_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_callback, RCL_RET_INVALID_ARGUMENT);
+
+  if (ros_goal_request_size <= 0) {
+    return RCL_RET_ERROR;
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+
+  action_server->allocator = executor->allocator;
+
+  // array bound check
+  if (executor->index >= executor->max_handles) {
+    rcl_ret_t ret = RCL_RET_ERROR;
+    RCL_SET_ERROR_MSG("Buffer overflow of 'executor->handles'. Increase 'max_handles'");
+    return ret;
+  }
+
+  // Init goal handles
+  action_server->goal_handles_memory =
+    executor->allocator->allocate(
+    handles_number * sizeof(rclc_action_goal_handle_t),
+    executor->allocator->state);
+  if (NULL == action_server->goal_handles_memory) {
+    return RCL_RET_ERROR;
+  }
+  action_server->goal_handles_memory_size = handles_number;
+  rclc_action_init_goal_handle_memory(action_server);
+
+  rclc_action_goal_handle_t * goal_handle = action_server->free_goal_handles;
+  size_t ros_goal_request_index = 0;
+  while (NULL != goal_handle) {
+    goal_handle->ros_goal_request =
+      (void *) &((uint8_t *)ros_goal_request)[ros_goal_request_index * ros_goal_request_size]; // NOLINT()
+    goal_handle->action_server = action_server;
+    ros_goal_request_index++;
+    goal_handle = goal_handle->next;
+  }
+
+  // assign data fields
+  executor->handles[executor->index].type = RCLC_ACTION_SERVER;
+  executor->handles[executor->index].action_server = action_server;
+  executor->handles[executor->index].action_server->goal_callback = goal_callback;
+  executor->handles[executor->index].action_server->cancel_callback = cancel_callback;
+  executor->handles[executor->index].invocation = ON_NEW_DATA;
+  executor->handles[executor->index].initialized = true;
+  executor->handles[executor->index].callback_context = context;
+
+  executor->handles[executor->index].action_server->goal_ended = false;
+  executor->handles[executor->index].action_server->goal_request_available = false;
+  executor->handles[executor->index].action_server->cancel_request_available = false;
+  executor->handles[executor->index].action_server->result_request_available = false;
+  executor->handles[executor->index].action_server->goal_expired_available = false;
+
+  // register handle and increase index of handle array
+  _rclc_executor_register_handle(executor);
+
+  // invalidate wait_set so that in next spin_some() call the
+  // 'executor->wait_set' is updated accordingly
+  if (rcl_wait_set_is_valid(&executor->wait_set)) {
+    ret = rcl_wait_set_fini(&executor->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCL_SET_ERROR_MSG("Could not reset wait_set in rclc_executor_add_action_server function.");
+      return ret;
+    }
+  }
+
+  size_t num_subscriptions = 0, num_guard_conditions = 0,
+    num_timers = 0, num_clients = 0, num_services = 0;
+
+  ret = rcl_action_server_wait_set_get_num_entities(
+    &action_server->rcl_handle,
+    &num_subscriptions,
+    &num_guard_conditions,
+    &num_timers,
+    &num_clients,
+    &num_services);
+
+  executor->info.number_of_subscriptions += num_subscriptions;
+  executor->info.number_of_guard_conditions += num_guard_conditions;
+  executor->info.number_of_timers += num_timers;
+  executor->info.number_of_clients += num_clients;
+  executor->info.number_of_services += num_services;
+
+  executor->info.number_of_action_servers++;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a action client.");
+  return ret;
+}
+
+/***
+ * operates on handle executor->handles[i]
+ * - evaluates the status bit in the wait_set for this handle
+ * - if new message is available or timer is ready, assigns executor->handles[i].data_available = true
+ */
+
+// todo refactor parameters: (rclc_executor_handle_t *, rcl_wait_set_t * wait_set)
+
+static
+rcl_ret_t
+_rclc_check_for_new_data(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_BATCH:
+    case RCLC_SUBSCRIPTION_LOANED:
+    case RCLC_SUBSCRIPTION_SERIALIZED:
+    case RCLC_SUBSCRIPTION_RING:
+      handle->data_available = (NULL != wait_set->subscriptions[handle->index]);
+      break;
+
+    case RCLC_TIMER:
+      // case RCLC_TIMER_WITH_CONTEXT:
+      handle->data_available = (NULL != wait_set->timers[handle->index]);
+      break;
+
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      handle->data_available = (NULL != wait_set->services[handle->index]);
+      break;
+
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      // case RCLC_CLIENT_WITH_CONTEXT:
+      handle->data_available = (NULL != wait_set->clients[handle->index]);
+      break;
+
+    case RCLC_GUARD_CONDITION:
+      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+      handle->data_available = (NULL != wait_set->guard_conditions[handle->index]);
+      break;
+
+    case RCLC_ACTION_CLIENT:
+      rc = rcl_action_client_wait_set_get_entities_ready(
+        wait_set,
+        &handle->action_client->rcl_handle,
+        &handle->action_client->feedback_available,
+        &handle->action_client->status_available,
+        &handle->action_client->goal_response_available,
+        &handle->action_client->cancel_response_available,
+        &handle->action_client->result_response_available
+      );
+      break;
+
+    case RCLC_ACTION_SERVER:
+      rc = rcl_action_server_wait_set_get_entities_ready(
+        wait_set,
+        &handle->action_server->rcl_handle,
+        &handle->action_server->goal_request_available,
+        &handle->action_server->cancel_request_available,
+        &handle->action_server->result_request_available,
+        &handle->action_server->goal_expired_available
+      );
+      break;
+
+    default:
+      RCUTILS_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error in _rclc_check_for_new_data:wait_set unknwon handle type: %d",
+        handle->type);
+      return RCL_RET_ERROR;
+  }    // switch-case
+  return rc;
+}
+
+// call rcl_take for subscription
+// todo change function signature (rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+
+static
+rcl_ret_t
+_rclc_take(rclc_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+
+  switch (handle->type) {
+    case RCLC_SUBSCRIPTION:
+    case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      if (wait_set->subscriptions[handle->index]) {
+        rmw_message_info_t messageInfo;
+        rc = rcl_take(
+          handle->subscription, handle->data, &messageInfo,
+          NULL);
+        if (rc != RCL_RET_OK) {
+          // rcl_take might return this error even with successfull rcl_wait
+          if (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          }
+          // invalidate that data is available, because rcl_take failed
+          if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            handle->data_available = false;
+          }
+          return rc;
+        }
+      }
+      break;
+
+    case RCLC_SUBSCRIPTION_BATCH:
+      handle->data_count = 0;
+      if (wait_set->subscriptions[handle->index]) {
+        rmw_message_info_t messageInfo;
+        while (handle->data_count < handle->data_capacity) {
+          rc = rcl_take(
+            handle->subscription,
+            (uint8_t *) handle->data + handle->data_count * handle->data_msg_size,
+            &messageInfo, NULL);
+          if (rc != RCL_RET_OK) {
+            break;
+          }
+          handle->data_count++;
+        }
+        if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+          // DDS queue is empty: successful, if at least one message was taken
+          if (handle->data_count > 0) {
+            rc = RCL_RET_OK;
+          } else {
+            handle->data_available = false;
+          }
+        } else if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+        }
+        return rc;
+      }
+      break;
+
+    case RCLC_SUBSCRIPTION_LOANED:
+      if (wait_set->subscriptions[handle->index]) {
+        rmw_message_info_t messageInfo;
+        // a loan, which was not returned after the last callback, is returned before
+        // the next message is taken
+        rc = _rclc_executor_return_pending_loan(handle);
+        if (rc != RCL_RET_OK) {
+          return rc;
+        }
+        if (rcl_subscription_can_loan_messages(handle->subscription)) {
+          rc = rcl_take_loaned_message(
+            handle->subscription, &handle->data_loaned, &messageInfo, NULL);
+          if (rc == RCL_RET_OK) {
+            break;
+          }
+          handle->data_loaned = NULL;
+          if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            handle->data_available = false;
+            return rc;
+          }
+          // the middleware could not loan a message: fall back to a copy
+          rcutils_reset_error();
+        }
+        rc = rcl_take(handle->subscription, handle->data, &messageInfo, NULL);
+        if (rc != RCL_RET_OK) {
+          if (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          } else {
+            handle->data_available = false;
+          }
+          return rc;
+        }
+      }
+      break;
+
+    case RCLC_SUBSCRIPTION_RING:
+      handle->data_count = 0;
+      if (wait_set->subscriptions[handle->index]) {
+        rmw_message_info_t messageInfo;
+        // take all available messages, the oldest message in the ring is overwritten
+        for (;; ) {
+          rc = rcl_take(
+            handle->subscription,
+            (uint8_t *) handle->data + handle->data_ring_head * handle->data_msg_size,
+            &messageInfo, NULL);
+          if (rc != RCL_RET_OK) {
+            break;
+          }
+          handle->data_ring_head = (handle->data_ring_head + 1) % handle->data_capacity;
+          if (handle->data_ring_size < handle->data_capacity) {
+            handle->data_ring_size++;
+          }
+          if (handle->data_count < handle->data_capacity) {
+            handle->data_count++;
+          }
+        }
+        // update the snapshot, which is passed to the callback, oldest message first
+        size_t pos = (handle->data_ring_head + handle->data_capacity - handle->data_ring_size) %
+          handle->data_capacity;
+        for (size_t i = 0; i < handle->data_ring_size; i++) {
+          handle->data_ring_snapshot[i] = (uint8_t *) handle->data + pos * handle->data_msg_size;
+          pos = (pos + 1) % handle->data_capacity;
+        }
+        if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+          // DDS queue is empty: successful, if at least one message was taken
+          if (handle->data_count > 0) {
+            rc = RCL_RET_OK;
+          } else {
+            handle->data_available = false;
+          }
+        } else if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+        }
+        return rc;
+      }
+      break;
+
+    case RCLC_SUBSCRIPTION_SERIALIZED:
+      if (wait_set->subscriptions[handle->index]) {
+        rmw_message_info_t messageInfo;
+        rcl_serialized_message_t * msg = (rcl_serialized_message_t *) handle->data;
+        size_t capacity = msg->buffer_capacity;
+        rc = rcl_take_serialized_message(handle->subscription, msg, &messageInfo, NULL);
+        if (rc != RCL_RET_OK) {
+          if (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take_serialized_message);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          } else {
+            handle->data_available = false;
+          }
+          return rc;
+        }
+        // the middleware resizes the buffer to the size of the message: grow the buffer
+        // geometrically, so that it is not resized for every slightly larger message
+        if ((msg->buffer_capacity > capacity) && (msg->buffer_capacity < 2 * capacity)) {
+          if (rmw_serialized_message_resize(msg, 2 * capacity) != RMW_RET_OK) {
+            // keep the buffer, which is large enough for the current message
+            rcutils_reset_error();
+          }
+        }
+      }
+      break;
+
+    case RCLC_TIMER:
+      // case RCLC_TIMER_WITH_CONTEXT:
+      // nothing to do
+      // notification, that timer is ready already done in _rclc_evaluate_data_availability()
+      break;
+
+    case RCLC_ACTION_CLIENT:
+      if (handle->action_client->goal_response_available) {
+        Generic_SendGoal_Response aux_goal_response;
+        rmw_request_id_t aux_goal_response_header;
+        rc = rcl_action_take_goal_response(
+          &handle->action_client->rcl_handle,
+          &aux_goal_response_header,
+          &aux_goal_response);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_goal_response);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle =
+          rclc_action_find_handle_by_goal_request_sequence_number(
+          handle->action_client, aux_goal_response_header.sequence_number);
+        if (NULL != goal_handle) {
+          goal_handle->available_goal_response = true;
+          goal_handle->goal_accepted = aux_goal_response.accepted;
+        }
+      }
+      if (handle->action_client->feedback_callback != NULL &&
+        handle->action_client->feedback_available)
+      {
+        rc = rcl_action_take_feedback(
+          &handle->action_client->rcl_handle,
+          handle->action_client->ros_feedback);
+
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_feedback);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
+          handle->action_client,
+          &handle->action_client->ros_feedback->goal_id);
+        if (NULL != goal_handle) {
+          goal_handle->available_feedback = true;
+        }
+      }
+      if (handle->action_client->cancel_response_available) {
+        rmw_request_id_t cancel_response_header;
+        rc = rcl_action_take_cancel_response(
+          &handle->action_client->rcl_handle,
+          &cancel_response_header,
+          &handle->action_client->ros_cancel_response);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_cancel_response);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle =
+          rclc_action_find_handle_by_cancel_request_sequence_number(
+          handle->action_client,
+          cancel_response_header.sequence_number);
+        if (NULL != goal_handle) {
+          goal_handle->available_cancel_response = true;
+          goal_handle->goal_cancelled = false;
+          for (size_t i = 0; i < handle->action_client->ros_cancel_response.goals_canceling.size;
+            i++)
+          {
+            rclc_action_goal_handle_t * aux = rclc_action_find_goal_handle_by_uuid(
+              handle->action_client,
+              &handle->action_client->ros_cancel_response.goals_canceling.data[i].goal_id);
+            if (NULL != aux) {
+              goal_handle->goal_cancelled = true;
+            }
+          }
+        }
+      }
+      if (handle->action_client->result_response_available) {
+        rmw_request_id_t result_request_header;
+        rc = rcl_action_take_result_response(
+          &handle->action_client->rcl_handle,
+          &result_request_header,
+          handle->action_client->ros_result_response);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_result_response);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle =
+          rclc_action_find_handle_by_result_request_sequence_number(
+          handle->action_client, result_request_header.sequence_number);
+        if (NULL != goal_handle) {
+          goal_handle->available_result_response = true;
+        }
+      }
+      break;
+
+    case RCLC_ACTION_SERVER:
+      if (handle->action_server->goal_request_available) {
+        rclc_action_goal_handle_t * goal_handle =
+          rclc_action_take_goal_handle(handle->action_server);
+        if (NULL != goal_handle) {
+          goal_handle->action_server = handle->action_server;
+          rc = rcl_action_take_goal_request(
+            &handle->action_server->rcl_handle,
+            &goal_handle->goal_request_header,
+            goal_handle->ros_goal_request);
+          if (rc != RCL_RET_OK) {
+            rclc_action_remove_used_goal_handle(handle->action_server, goal_handle);
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_goal_request);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+            return rc;
+          }
+          goal_handle->goal_id = goal_handle->ros_goal_request->goal_id;
+          goal_handle->status = GOAL_STATE_UNKNOWN;
+        }
+      }
+      if (handle->action_server->result_request_available) {
+        Generic_GetResult_Request aux_result_request;
+        rmw_request_id_t aux_result_request_header;
+        rc = rcl_action_take_result_request(
+          &handle->action_server->rcl_handle,
+          &aux_result_request_header,
+          &aux_result_request);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_result_request);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
+          handle->action_server, &aux_result_request.goal_id);
+        if (NULL != goal_handle) {
+          goal_handle->result_request_header = aux_result_request_header;
+          goal_handle->status = GOAL_STATE_EXECUTING;
+        }
+        handle->action_server->result_request_available = false;
+      }
+      if (handle->action_server->cancel_request_available) {
+        action_msgs__srv__CancelGoal_Request aux_cancel_request;
+        rmw_request_id_t aux_cancel_request_header;
+
+        rc = rcl_action_take_cancel_request(
+          &handle->action_server->rcl_handle,
+          &aux_cancel_request_header,
+          &aux_cancel_request);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_cancel_request);
+          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          return rc;
+        }
+        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
+          handle->action_server, &aux_cancel_request.goal_info.goal_id);
+        if (NULL != goal_handle) {
+          if (GOAL_STATE_CANCELING == rcl_action_transition_goal_state(
+              goal_handle->status, GOAL_EVENT_CANCEL_GOAL))
+          {
+            goal_handle->cancel_request_header = aux_cancel_request_header;
+            goal_handle->status = GOAL_STATE_CANCELING;
+          } else {
+            rclc_action_server_goal_cancel_reject(
+              handle->action_server, CANCEL_STATE_TERMINATED,
+              aux_cancel_request_header);
+          }
+        } else {
+          rclc_action_server_goal_cancel_reject(
+            handle->action_server, CANCEL_STATE_UNKNOWN_GOAL,
+            aux_cancel_request_header);
+        }
+      }
+      break;
+
+    case RCLC_SERVICE:
+    case RCLC_SERVICE_WITH_REQUEST_ID:
+    case RCLC_SERVICE_WITH_CONTEXT:
+      if (wait_set->services[handle->index]) {
+        rc = rcl_take_request(
+          handle->service, &handle->req_id, handle->data);
+        if (rc != RCL_RET_OK) {
+          // rcl_take_request might return this error even with successfull rcl_wait
+          if (rc != RCL_RET_SERVICE_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take_request);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          }
+          // invalidate that data is available, because rcl_take failed
+          if (rc == RCL_RET_SERVICE_TAKE_FAILED) {
+            handle->data_available = false;
+          }
+          return rc;
+        }
+      }
+      break;
+
+    case RCLC_CLIENT:
+    case RCLC_CLIENT_WITH_REQUEST_ID:
+      // case RCLC_CLIENT_WITH_CONTEXT:
+      if (wait_set->clients[handle->index]) {
+        rc = rcl_take_response(
+          handle->client, &handle->req_id, handle->data);
+        if (rc != RCL_RET_OK) {
+          // rcl_take_response might return this error even with successfull rcl_wait
+          if (rc != RCL_RET_CLIENT_TAKE_FAILED) {
+            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take_response);
+            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
+          }
+          return rc;
+        }
+      }
+      break;
+
+    case RCLC_GUARD_CONDITION:
+      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+      // nothing to do
+      break;
+
+    default:
+      RCUTILS_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Error in _rclc_take_new_data:wait_set unknwon handle type: %d",
+        handle->type);
+      return RCL_RET_ERROR;
+  }    // switch-case
+  return rc;
+}
+
+bool _rclc_check_handle_data_available(rclc_executor_handle_t * handle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, false);
+
+  switch (handle->type) {
+    case RCLC_ACTION_CLIENT:
+      if (handle->action_client->feedback_available ||
+        handle->action_client->status_available ||
+        handle->action_client->goal_response_available ||
+        handle->action_client->cancel_response_available ||
+        handle->action_client->result_response_available)
+      {
+        return true;
+      }
+      break;
+
+    case RCLC_ACTION_SERVER:
+      if (handle->action_server->goal_request_available ||
+        handle->action_server->cancel_request_available ||
+        handle->action_server->goal_expired_available ||
+        handle->action_server->result_request_available ||
+        handle->action_server->goal_ended)
+      {
+        return true;
+      }
+      break;
+
+    default:
+      if (handle->data_available) {
+        return true;
+      }
+      break;
+  }  // switch-case
+
+  return false;
+}
+
+/***
+ * operates on executor->handles[i] object
+ * - calls every callback of each object depending on its type
+ */
+
+// todo change parametes (rclc_executor_handle_t * handle)
+
+/***
+ * takes new data of a handle and counts failed takes in the statistics of the handle
+ */
+static
+rcl_ret_t
+_rclc_take_new_data(
+  rclc_executor_handle_t * handle,
+  rcl_wait_set_t * wait_set,
+  const rclc_executor_monitoring_t * monitoring)
+{
+  rcl_ret_t rc = _rclc_take(handle, wait_set);
+  if (NULL != monitoring->trace) {
+    rclc_executor_trace_record(
+      monitoring->trace, RCLC_EXECUTOR_TRACE_TAKE, (uint32_t) handle->registration_number, rc);
+  }
+  if (monitoring->statistics_enabled &&
+    ((rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) || (rc == RCL_RET_SERVICE_TAKE_FAILED) ||
+    (rc == RCL_RET_CLIENT_TAKE_FAILED)))
+  {
+    handle->statistics.take_failures++;
+  }
+  return rc;
+}
+
+static
+rcl_ret_t
+_rclc_execute(rclc_executor_handle_t * handle, const rclc_executor_monitoring_t * monitoring)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(monitoring, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+  bool invoke_callback = false;
+  bool timed = false;
+  rcutils_time_point_value_t start_time = 0;
+
+  // determine, if callback shall be called
+  if (handle->invocation == ON_NEW_DATA &&
+    _rclc_check_handle_data_available(handle))
+  {
+    invoke_callback = true;
+  }
+
+  if (handle->invocation == ALWAYS) {
+    invoke_callback = true;
+  }
+
+  // the callback is timed for the runtime statistics and for the WCET monitoring
+  if (invoke_callback && (monitoring->statistics_enabled || (handle->wcet_ns > 0))) {
+    timed = (rcutils_steady_time_now(&start_time) == RCUTILS_RET_OK);
+  }
+  if (invoke_callback && (NULL != monitoring->trace)) {
+    rclc_executor_trace_record(
+      monitoring->trace, RCLC_EXECUTOR_TRACE_CALLBACK_START,
+      (uint32_t) handle->registration_number, 0);
+  }
+
+  // execute callback
+  if (invoke_callback) {
+    switch (handle->type) {
+      case RCLC_SUBSCRIPTION:
+        if (handle->data_available) {
+          handle->subscription_callback(handle->data);
+        } else {
+          handle->subscription_callback(NULL);
+        }
+        break;
+
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+        if (handle->data_available) {
+          handle->subscription_callback_with_context(
+            handle->data,
+            handle->callback_context);
+        } else {
+          handle->subscription_callback_with_context(
+            NULL,
+            handle->callback_context);
+        }
+        break;
+
+      case RCLC_SUBSCRIPTION_BATCH:
+        if (handle->data_available) {
+          handle->subscription_batch_callback(
+            handle->data,
+            handle->data_count,
+            handle->callback_context);
+        } else {
+          handle->subscription_batch_callback(
+            NULL,
+            0,
+            handle->callback_context);
+        }
+        break;
+
+      case RCLC_SUBSCRIPTION_RING:
+        // the messages of previous spins are passed also, if no new message is available
+        handle->subscription_ring_callback(
+          (handle->data_ring_size > 0) ? handle->data_ring_snapshot : NULL,
+          handle->data_ring_size,
+          handle->data_available ? handle->data_count : 0,
+          handle->callback_context);
+        break;
+
+      case RCLC_SUBSCRIPTION_SERIALIZED:
+        if (handle->data_available) {
+          handle->subscription_serialized_callback(
+            (const rcl_serialized_message_t *) handle->data,
+            handle->callback_context);
+        } else {
+          handle->subscription_serialized_callback(
+            NULL,
+            handle->callback_context);
+        }
+        break;
+
+      case RCLC_SUBSCRIPTION_LOANED:
+        if (handle->data_available) {
+          handle->subscription_callback_with_context(
+            (NULL != handle->data_loaned) ? handle->data_loaned : handle->data,
+            handle->callback_context);
+        } else {
+          handle->subscription_callback_with_context(
+            NULL,
+            handle->callback_context);
+        }
+        // return the loan after the callback has finished
+        if (NULL != handle->data_loaned) {
+          rc = rcl_return_loaned_message_from_subscription(
+            handle->subscription, handle->data_loaned);
+          handle->data_loaned = NULL;
+          if (rc != RCL_RET_OK) {
+            PRINT_RCLC_ERROR(rclc_execute, rcl_return_loaned_message_from_subscription);
+            return rc;
+          }
+        }
+        break;
+
+      case RCLC_TIMER:
+        // case RCLC_TIMER_WITH_CONTEXT:
+        rc = rcl_timer_call(handle->timer);
+
+        // cancled timer are not handled, return success
+        if (rc == RCL_RET_TIMER_CANCELED) {
+          rc = RCL_RET_OK;
+          break;
+        }
+
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_execute, rcl_timer_call);
+          return rc;
+        }
+        break;
+
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        // differentiate user-side service types
+        switch (handle->type) {
+          case RCLC_SERVICE:
+            handle->service_callback(
+              handle->data,
+              handle->data_response_msg);
+            break;
+          case RCLC_SERVICE_WITH_REQUEST_ID:
+            handle->service_callback_with_reqid(
+              handle->data,
+              &handle->req_id,
+              handle->data_response_msg);
+            break;
+          case RCLC_SERVICE_WITH_CONTEXT:
+            handle->service_callback_with_context(
+              handle->data,
+              handle->data_response_msg,
+              handle->callback_context);
+            break;
+          default:
+            break;  // flow can't reach here
+        }
+        // handle rcl-side services
+        rc = rcl_send_response(handle->service, &handle->req_id, handle->data_response_msg);
+        if (rc != RCL_RET_OK) {
+          PRINT_RCLC_ERROR(rclc_execute, rcl_send_response);
+          return rc;
+        }
+        break;
+
+      case RCLC_CLIENT:
+        handle->client_callback(handle->data);
+        break;
+
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        handle->client_callback_with_reqid(handle->data, &handle->req_id);
+        break;
+
+      // case RCLC_CLIENT_WITH_CONTEXT:   //TODO
+      //   break;
+
+      case RCLC_GUARD_CONDITION:
+        handle->gc_callback();
+        break;
+
+      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:  //TODO
+      //   break;
+
+      case RCLC_ACTION_CLIENT:
+        // TODO(pablogs9): Handle action client status
+        if (handle->action_client->goal_response_available) {
+          // Handle action client goal response messages
+          //
+          // Pre-condition:
+          // - goal in action_client->used_goal_handles list
+          // - goal->available_goal_response = true
+          //
+          // Post-condition:
+          // - goal->available_goal_response = false
+          rclc_action_goal_handle_t * goal_handle;
+          while (goal_handle =
+            rclc_action_find_first_handle_with_goal_response(handle->action_client),
+            NULL != goal_handle)
+          {
+            // Set post-condition
+            goal_handle->available_goal_response = false;
+            handle->action_client->goal_callback(
+              goal_handle, goal_handle->goal_accepted,
+              handle->callback_context);
+            if (!goal_handle->goal_accepted ||
+              RCL_RET_OK != rclc_action_send_result_request(goal_handle))
+            {
+              rclc_action_remove_used_goal_handle(handle->action_client, goal_handle);
+            } else {
+              goal_handle->status = GOAL_STATE_ACCEPTED;
+            }
+          }
+        }
+        if (handle->action_client->feedback_available) {
+          rclc_action_goal_handle_t * goal_handle;
+          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
+            goal_handle = goal_handle->next)
+          {
+            if (goal_handle->available_feedback) {
+              goal_handle->available_feedback = false;
+
+              if (handle->action_client->feedback_callback != NULL) {
+                handle->action_client->feedback_callback(
+                  goal_handle,
+                  handle->action_client->ros_feedback,
+                  handle->callback_context);
+              }
+            }
+          }
+        }
+        if (handle->action_client->cancel_response_available) {
+          rclc_action_goal_handle_t * goal_handle;
+          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
+            goal_handle = goal_handle->next)
+          {
+            if (goal_handle->available_cancel_response) {
+              goal_handle->available_cancel_response = false;
+
+              if (handle->action_client->cancel_callback != NULL) {
+                handle->action_client->cancel_callback(
+                  goal_handle,
+                  goal_handle->goal_cancelled,
+                  handle->callback_context);
+              }
+            }
+          }
+        }
+        if (handle->action_client->result_response_available) {
+          // Handle action client result response messages
+          //
+          // Pre-condition:
+          // - goal in action_client->used_goal_handles list
+          // - goal->available_result_response = true
+          //
+          // Post-condition:
+          // - goal->available_result_response = false
+          // - goal deleted from action_client->used_goal_handles list
+          rclc_action_goal_handle_t * goal_handle;
+          while (goal_handle =
+            rclc_action_find_first_handle_with_result_response(handle->action_client),
+            NULL != goal_handle)
+          {
+            // Set first post-condition:
+            goal_handle->available_result_response = false;
+            handle->action_client->result_callback(
+              goal_handle,
+              handle->action_client->ros_result_response,
+              handle->callback_context);
+
+            // Set second post-condition
+            rclc_action_remove_used_goal_handle(handle->action_client, goal_handle);
+          }
+        }
+        break;
+
+      case RCLC_ACTION_SERVER:
+        if (handle->action_server->goal_ended) {
+          // Handle action server terminated goals (succeeded, canceled or aborted)
+          //
+          // Pre-condition:
+          // - goal in action_server->used_goal_handles list
+          // - goal->status > GOAL_STATE_CANCELING
+          //
+          // Post-condition:
+          // - goal deleted from action_server->used_goal_handles list
+          rclc_action_goal_handle_t * goal_handle;
+          while (goal_handle =
+            rclc_action_find_first_terminated_handle(handle->action_server),
+            NULL != goal_handle)
+          {
+            // Set post-condition
+            rclc_action_remove_used_goal_handle(goal_handle->action_server, goal_handle);
+          }
+          handle->action_server->goal_ended = false;
+        }
+        if (handle->action_server->goal_request_available) {
+          // Handle action server goal request messages
+          //
+          // Pre-condition:
+          // - goal in action_server->used_goal_handles list
+          // - goal->status = GOAL_STATE_UNKNOWN
+          //
+          // Accepted post-condition:
+          // - goal->status = GOAL_STATE_ACCEPTED
+          // Rejected/Error post-condition:
+          // - goal deleted from action_server->used_goal_handles list
+          rclc_action_goal_handle_t * goal_handle;
+          while (goal_handle =
+            rclc_action_find_first_handle_by_status(handle->action_server, GOAL_STATE_UNKNOWN),
+            NULL != goal_handle)
+          {
+            rcl_ret_t ret = handle->action_server->goal_callback(
+              goal_handle,
+              handle->callback_context);
+            switch (ret) {
+              case RCL_RET_ACTION_GOAL_ACCEPTED:
+                rclc_action_server_response_goal_request(goal_handle, true);
+                // Set accepted post-condition
+                goal_handle->status = GOAL_STATE_ACCEPTED;
+                break;
+              case RCL_RET_ACTION_GOAL_REJECTED:
+              default:
+                rclc_action_server_response_goal_request(goal_handle, false);
+                // Set rejected/error post-condition
+                rclc_action_remove_used_goal_handle(handle->action_server, goal_handle);
+                break;
+            }
+          }
+          handle->action_server->goal_request_available = false;
+        }
+        if (handle->action_server->cancel_request_available) {
+          rclc_action_goal_handle_t * goal_handle;
+          for (goal_handle = handle->action_server->used_goal_handles; NULL != goal_handle;
+            goal_handle = goal_handle->next)
+          {
+            if (GOAL_STATE_CANCELING == goal_handle->status) {
+              goal_handle->goal_cancelled =
+                handle->action_server->cancel_callback(goal_handle, handle->callback_context);
+              if (goal_handle->goal_cancelled) {
+                rclc_action_server_goal_cancel_accept(goal_handle);
+              } else {
+                rclc_action_server_goal_cancel_reject(
+                  handle->action_server, CANCEL_STATE_REJECTED,
+                  goal_handle->cancel_request_header);
+                goal_handle->status = GOAL_STATE_EXECUTING;
+              }
+            }
+          }
+          handle->action_server->cancel_request_available = false;
         }
+        break;
+
+      default:
+        RCUTILS_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Error in _rclc_execute: unknwon handle type: %d",
+          handle->type);
+        return RCL_RET_ERROR;
+    }   // switch-case
+  }
+
+  if (invoke_callback && (NULL != monitoring->trace)) {
+    rclc_executor_trace_record(
+      monitoring->trace, RCLC_EXECUTOR_TRACE_CALLBACK_END,
+      (uint32_t) handle->registration_number, 0);
+  }
+  rcutils_time_point_value_t finish_time;
+  if (timed && (rcutils_steady_time_now(&finish_time) == RCUTILS_RET_OK)) {
+    uint64_t duration_ns = (uint64_t) (finish_time - start_time);
+    if (monitoring->statistics_enabled) {
+      rclc_executor_handle_statistics_record(&handle->statistics, duration_ns);
+    }
+    if ((handle->wcet_ns > 0) && (duration_ns > handle->wcet_ns)) {
+      handle->wcet_overruns++;
+      if (duration_ns > handle->wcet_worst_ns) {
+        handle->wcet_worst_ns = duration_ns;
+      }
+      if (NULL != monitoring->overrun_callback) {
+        monitoring->overrun_callback(
+          rclc_executor_handle_get_ptr(handle), duration_ns, handle->wcet_ns,
+          monitoring->overrun_context);
       }
+    }
+  }
+
+  return rc;
+}
+
+
+/***
+ * returns true, if the dispatch budget of the current spin is set and used up
+ */
+static
+bool
+_rclc_executor_dispatch_budget_used_up(const rclc_executor_t * executor)
+{
+  return (executor->dispatch_budget_ns > 0) &&
+         ((rclc_monotonic_time_ns() - executor->dispatch_start_ns) >=
+         (int64_t) executor->dispatch_budget_ns);
+}
+
+/***
+ * takes further messages of a subscription, which has been processed in this spin,
+ * and calls the callback once per message, until the DDS queue is empty,
+ * handle->max_takes_per_spin messages have been processed or the dispatch budget is used
+ * up. The remaining messages stay in the DDS queue for the next spin.
+ */
+static
+rcl_ret_t
+_rclc_take_and_execute_remaining(rclc_executor_t * executor, rclc_executor_handle_t * handle)
+{
+  rcl_ret_t rc = RCL_RET_OK;
+
+  if ((handle->type != RCLC_SUBSCRIPTION) && (handle->type != RCLC_SUBSCRIPTION_WITH_CONTEXT) &&
+    (handle->type != RCLC_SUBSCRIPTION_LOANED) && (handle->type != RCLC_SUBSCRIPTION_SERIALIZED))
+  {
+    return rc;
+  }
+
+  // first message has already been processed
+  for (size_t takes = 1;
+    handle->data_available &&
+    ((handle->max_takes_per_spin == RCLC_TAKE_UNTIL_EMPTY) ||
+    (takes < handle->max_takes_per_spin));
+    takes++)
+  {
+    if (_rclc_executor_dispatch_budget_used_up(executor)) {
       break;
+    }
+    rc = _rclc_take_new_data(handle, &executor->wait_set, &executor->monitoring);
+    if (rc == RCL_RET_SUBSCRIPTION_TAKE_FAILED) {
+      // DDS queue is empty, data_available is reset by _rclc_take_new_data
+      return RCL_RET_OK;
+    }
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    rc = _rclc_execute(handle, &executor->monitoring);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+/***
+ * checks all handles for new data in the wait_set and collects the indices of the handles,
+ * which have new data or are invoked ALWAYS, in executor->ready_list in the order of
+ * executor->dispatch_order. This is the only O(n) pass per spin, all following steps only
+ * iterate over the ready list. The pass reads only executor->hot_handles, the handle itself
+ * is only accessed if it has new data or is an action client/server.
+ *
+ * All handles, which are not in the ready list, have data_available == false. Therefore
+ * only the handles of the previous ready list need to be reset.
+ *
+ * Handles, which have been deferred in the previous spin, because the dispatch budget was
+ * used up, keep their state and are put at the beginning of the ready list.
+ */
+static
+rcl_ret_t
+_rclc_executor_collect_ready_handles(rclc_executor_t * executor)
+{
+  rcl_ret_t rc = RCL_RET_OK;
+  bool has_deferred = (executor->deferred_list_size > 0);
+
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    rclc_executor_handle_t * handle = &executor->handles[executor->ready_list[i]];
+    if (!handle->deferred) {
+      handle->data_available = false;
+    }
+  }
+  executor->ready_list_size = 0;
+  for (size_t i = 0; i < executor->index; i++) {
+    const rclc_executor_handle_hot_t * hot = &executor->hot_handles[i];
+    if (has_deferred && executor->handles[hot->handle_index].deferred) {
+      continue;
+    }
+    if (NULL != hot->wait_set_entry) {
+      if (NULL != *hot->wait_set_entry) {
+        executor->handles[hot->handle_index].data_available = true;
+        executor->ready_list[executor->ready_list_size++] = hot->handle_index;
+      } else if (hot->always) {
+        executor->ready_list[executor->ready_list_size++] = hot->handle_index;
+      }
+      continue;
+    }
+    rclc_executor_handle_t * handle = &executor->handles[hot->handle_index];
+    rc = _rclc_check_for_new_data(handle, &executor->wait_set);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+      return rc;
+    }
+    if (hot->always || _rclc_check_handle_data_available(handle)) {
+      executor->ready_list[executor->ready_list_size++] = hot->handle_index;
+    }
+  }
+
+  // deferred handles first, the lists are disjoint and both fit into max_handles entries
+  executor->carried_over_size = executor->deferred_list_size;
+  if (has_deferred) {
+    memmove(
+      &executor->ready_list[executor->deferred_list_size], executor->ready_list,
+      executor->ready_list_size * sizeof(size_t));
+    memcpy(
+      executor->ready_list, executor->deferred_list,
+      executor->deferred_list_size * sizeof(size_t));
+    executor->ready_list_size += executor->deferred_list_size;
+  }
+  return RCL_RET_OK;
+}
+
+/***
+ * checks the dispatch budget before the handle at \p position of the ready list is executed.
+ * If the budget is used up, the handles ready_list[position..] are deferred to the next spin
+ * and true is returned. At least one handle is executed per spin.
+ */
+static
+bool
+_rclc_executor_dispatch_budget_exhausted(rclc_executor_t * executor, size_t position)
+{
+  if ((position == 0) || (position >= executor->ready_list_size) ||
+    !_rclc_executor_dispatch_budget_used_up(executor))
+  {
+    return false;
+  }
+  size_t deferred = executor->ready_list_size - position;
+  for (size_t i = 0; i < deferred; i++) {
+    size_t handle_index = executor->ready_list[position + i];
+    executor->deferred_list[i] = handle_index;
+    executor->handles[handle_index].deferred = true;
+  }
+  executor->deferred_list_size = deferred;
+  executor->deferred_runnable = true;
+  executor->budget_statistics.exhausted_spins++;
+  executor->budget_statistics.deferred_handles += deferred;
+  executor->budget_statistics.deferred_handles_last = deferred;
+  return true;
+}
+
+/***
+ * sets the bits of the handles in executor->ready_list, which have new data, in
+ * executor->ready_bitmap and returns their number. Handles, which are only in the ready list,
+ * because they are invoked ALWAYS, are not ready.
+ */
+static
+size_t
+_rclc_executor_update_ready_bitmap(rclc_executor_t * executor)
+{
+  size_t data_available_count = 0;
+  memset(executor->ready_bitmap, 0, executor->ready_bitmap_words * sizeof(uint64_t));
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    size_t handle_index = executor->ready_list[i];
+    if (_rclc_check_handle_data_available(&executor->handles[handle_index])) {
+      executor->ready_bitmap[handle_index / 64] |= (uint64_t) 1 << (handle_index % 64);
+      data_available_count++;
+    }
+  }
+  return data_available_count;
+}
 
-    case RCLC_ACTION_SERVER:
-      if (handle->action_server->goal_request_available) {
-        rclc_action_goal_handle_t * goal_handle =
-          rclc_action_take_goal_handle(handle->action_server);
-        if (NULL != goal_handle) {
-          goal_handle->action_server = handle->action_server;
-          rc = rcl_action_take_goal_request(
-            &handle->action_server->rcl_handle,
-            &goal_handle->goal_request_header,
-            goal_handle->ros_goal_request);
-          if (rc != RCL_RET_OK) {
-            rclc_action_remove_used_goal_handle(handle->action_server, goal_handle);
-            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_goal_request);
-            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-            return rc;
-          }
-          goal_handle->goal_id = goal_handle->ros_goal_request->goal_id;
-          goal_handle->status = GOAL_STATE_UNKNOWN;
-        }
+/***
+ * compiles the rcl-handles of a trigger group into a bitmask of \p words words over
+ * executor->handles
+ */
+static
+void
+_rclc_executor_compile_trigger_group(
+  rclc_executor_t * executor,
+  rclc_trigger_group_t * group,
+  size_t words)
+{
+  memset(group->mask, 0, words * sizeof(uint64_t));
+  group->complete = true;
+  for (size_t i = 0; i < group->size; i++) {
+    size_t pos = _rclc_executor_handle_map_find(executor, group->rcl_handles[i]);
+    if (pos == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+      group->complete = false;
+      continue;
+    }
+    size_t handle_index = executor->handle_map[pos];
+    group->mask[handle_index / 64] |= (uint64_t) 1 << (handle_index % 64);
+  }
+}
+
+/***
+ * compiles the trigger object of the built-in trigger functions trigger_expression and
+ * trigger_deadline into bitmasks over executor->handles
+ */
+static
+void
+_rclc_executor_compile_trigger(rclc_executor_t * executor)
+{
+  if (NULL == executor->trigger_object) {
+    return;
+  }
+  if (executor->trigger_function == rclc_executor_trigger_expression) {
+    rclc_trigger_expression_t * expression =
+      (rclc_trigger_expression_t *) executor->trigger_object;
+    for (size_t g = 0; g < expression->size; g++) {
+      _rclc_executor_compile_trigger_group(executor, &expression->groups[g], expression->words);
+    }
+  } else if (executor->trigger_function == rclc_executor_trigger_deadline) {
+    rclc_trigger_deadline_t * deadline = (rclc_trigger_deadline_t *) executor->trigger_object;
+    _rclc_executor_compile_trigger_group(executor, &deadline->inputs, deadline->words);
+  }
+}
+
+/***
+ * updates the state of a deadline trigger with the ready inputs of this spin and returns
+ * true, if all inputs are ready or the maximum waiting time since the first ready input has
+ * elapsed
+ */
+static
+bool
+_rclc_trigger_deadline_update(rclc_trigger_deadline_t * trigger, bool all_ready, bool any_ready)
+{
+  if (all_ready) {
+    trigger->waiting = false;
+    return true;
+  }
+  if (!any_ready && !trigger->waiting) {
+    return false;
+  }
+  int64_t now = rclc_monotonic_time_ns();
+  if (!trigger->waiting) {
+    trigger->waiting = true;
+    trigger->first_input_time_ns = now;
+  }
+  if ((now - trigger->first_input_time_ns) >= (int64_t) trigger->max_wait_ns) {
+    trigger->waiting = false;
+    trigger->expirations++;
+    return true;
+  }
+  return false;
+}
+
+/***
+ * evaluates a deadline trigger on executor->ready_bitmap and marks the fresh inputs,
+ * if it is fulfilled
+ */
+static
+bool
+_rclc_executor_check_trigger_deadline(
+  rclc_executor_t * executor,
+  rclc_trigger_deadline_t * trigger)
+{
+  bool all_ready = trigger->inputs.complete;
+  bool any_ready = false;
+  for (size_t w = 0; w < executor->ready_bitmap_words; w++) {
+    uint64_t ready = executor->ready_bitmap[w] & trigger->inputs.mask[w];
+    all_ready = all_ready && (ready == trigger->inputs.mask[w]);
+    any_ready = any_ready || (ready != 0);
+  }
+  if (!_rclc_trigger_deadline_update(trigger, all_ready, any_ready)) {
+    return false;
+  }
+  for (size_t i = 0; i < trigger->inputs.size; i++) {
+    size_t pos = _rclc_executor_handle_map_find(executor, trigger->inputs.rcl_handles[i]);
+    trigger->fresh[i] = false;
+    if (pos != RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+      size_t handle_index = executor->handle_map[pos];
+      trigger->fresh[i] = (executor->ready_bitmap[handle_index / 64] >> (handle_index % 64)) & 1;
+    }
+  }
+  return true;
+}
+
+/***
+ * evaluates the trigger condition. The built-in trigger functions are evaluated on
+ * executor->ready_bitmap, which is built from executor->ready_list, user-defined trigger
+ * functions are called with all handles.
+ */
+static
+bool
+_rclc_executor_check_trigger(rclc_executor_t * executor)
+{
+  rclc_executor_trigger_t trigger = executor->trigger_function;
+
+  if (trigger == rclc_executor_trigger_always) {
+    return true;
+  }
+  if ((trigger == rclc_executor_trigger_any) ||
+    (trigger == rclc_executor_trigger_all) ||
+    (trigger == rclc_executor_trigger_one) ||
+    (trigger == rclc_executor_trigger_expression) ||
+    (trigger == rclc_executor_trigger_deadline))
+  {
+    size_t data_available_count = _rclc_executor_update_ready_bitmap(executor);
+    if (trigger == rclc_executor_trigger_any) {
+      return data_available_count > 0;
+    }
+    if (trigger == rclc_executor_trigger_all) {
+      return data_available_count == executor->index;
+    }
+    if (trigger == rclc_executor_trigger_one) {
+      if (NULL == executor->trigger_object) {
+        return false;
       }
-      if (handle->action_server->result_request_available) {
-        Generic_GetResult_Request aux_result_request;
-        rmw_request_id_t aux_result_request_header;
-        rc = rcl_action_take_result_request(
-          &handle->action_server->rcl_handle,
-          &aux_result_request_header,
-          &aux_result_request);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_result_request);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
-          handle->action_server, &aux_result_request.goal_id);
-        if (NULL != goal_handle) {
-          goal_handle->result_request_header = aux_result_request_header;
-          goal_handle->status = GOAL_STATE_EXECUTING;
-        }
-        handle->action_server->result_request_available = false;
+      size_t pos = _rclc_executor_handle_map_find(executor, executor->trigger_object);
+      if (pos == RCLC_EXECUTOR_HANDLE_MAP_EMPTY) {
+        return false;
       }
-      if (handle->action_server->cancel_request_available) {
-        action_msgs__srv__CancelGoal_Request aux_cancel_request;
-        rmw_request_id_t aux_cancel_request_header;
+      size_t handle_index = executor->handle_map[pos];
+      return (executor->ready_bitmap[handle_index / 64] >> (handle_index % 64)) & 1;
+    }
+    if (NULL == executor->trigger_object) {
+      return false;
+    }
+    if (trigger == rclc_executor_trigger_deadline) {
+      return _rclc_executor_check_trigger_deadline(
+        executor, (rclc_trigger_deadline_t *) executor->trigger_object);
+    }
+    return rclc_trigger_expression_evaluate(
+      (const rclc_trigger_expression_t *) executor->trigger_object,
+      executor->ready_bitmap, executor->ready_bitmap_words);
+  }
+  return trigger(executor->handles, (unsigned int) executor->max_handles,
+           executor->trigger_object);
+}
 
-        rc = rcl_action_take_cancel_request(
-          &handle->action_server->rcl_handle,
-          &aux_cancel_request_header,
-          &aux_cancel_request);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_take_new_data, rcl_action_take_cancel_request);
-          RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          return rc;
-        }
-        rclc_action_goal_handle_t * goal_handle = rclc_action_find_goal_handle_by_uuid(
-          handle->action_server, &aux_cancel_request.goal_info.goal_id);
-        if (NULL != goal_handle) {
-          if (GOAL_STATE_CANCELING == rcl_action_transition_goal_state(
-              goal_handle->status, GOAL_EVENT_CANCEL_GOAL))
-          {
-            goal_handle->cancel_request_header = aux_cancel_request_header;
-            goal_handle->status = GOAL_STATE_CANCELING;
-          } else {
-            rclc_action_server_goal_cancel_reject(
-              handle->action_server, CANCEL_STATE_TERMINATED,
-              aux_cancel_request_header);
-          }
-        } else {
-          rclc_action_server_goal_cancel_reject(
-            handle->action_server, CANCEL_STATE_UNKNOWN_GOAL,
-            aux_cancel_request_header);
-        }
-      }
-      break;
+/***
+ * evaluates the trigger condition and records the result in the trace
+ */
+static
+bool
+_rclc_executor_evaluate_trigger(rclc_executor_t * executor)
+{
+  bool result = _rclc_executor_check_trigger(executor);
+  if (result && (executor->deferred_list_size > 0)) {
+    // the deferred handles are executed in this spin
+    for (size_t i = 0; i < executor->deferred_list_size; i++) {
+      executor->handles[executor->deferred_list[i]].deferred = false;
+    }
+    executor->deferred_list_size = 0;
+  } else if (!result) {
+    // the deferred handles wait like all other handles until the trigger is fulfilled
+    executor->deferred_runnable = false;
+  }
+  if (NULL != executor->monitoring.trace) {
+    rclc_executor_trace_record(
+      executor->monitoring.trace, RCLC_EXECUTOR_TRACE_TRIGGER,
+      RCLC_EXECUTOR_TRACE_NO_HANDLE, result);
+  }
+  return result;
+}
 
-    case RCLC_SERVICE:
-    case RCLC_SERVICE_WITH_REQUEST_ID:
-    case RCLC_SERVICE_WITH_CONTEXT:
-      if (wait_set->services[handle->index]) {
-        rc = rcl_take_request(
-          handle->service, &handle->req_id, handle->data);
-        if (rc != RCL_RET_OK) {
-          // rcl_take_request might return this error even with successfull rcl_wait
-          if (rc != RCL_RET_SERVICE_TAKE_FAILED) {
-            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take_request);
-            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          }
-          // invalidate that data is available, because rcl_take failed
-          if (rc == RCL_RET_SERVICE_TAKE_FAILED) {
-            handle->data_available = false;
-          }
-          return rc;
-        }
-      }
-      break;
+static
+rcl_ret_t
+_rclc_default_scheduling(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
 
-    case RCLC_CLIENT:
-    case RCLC_CLIENT_WITH_REQUEST_ID:
-      // case RCLC_CLIENT_WITH_CONTEXT:
-      if (wait_set->clients[handle->index]) {
-        rc = rcl_take_response(
-          handle->client, &handle->req_id, handle->data);
-        if (rc != RCL_RET_OK) {
-          // rcl_take_response might return this error even with successfull rcl_wait
-          if (rc != RCL_RET_CLIENT_TAKE_FAILED) {
-            PRINT_RCLC_ERROR(rclc_take_new_data, rcl_take_response);
-            RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Error number: %d", rc);
-          }
-          return rc;
-        }
+  rc = _rclc_executor_collect_ready_handles(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  // if the trigger condition is fullfilled, fetch data and execute
+  if (_rclc_executor_evaluate_trigger(executor)) {
+    // take new input data from DDS-queue and execute the corresponding callback of the handle
+    // in the order of executor->dispatch_order
+    for (size_t i = 0; i < executor->ready_list_size; i++) {
+      if (_rclc_executor_dispatch_budget_exhausted(executor, i)) {
+        break;
       }
-      break;
+      rclc_executor_handle_t * handle = &executor->handles[executor->ready_list[i]];
+      rc = _rclc_take_new_data(handle, &executor->wait_set, &executor->monitoring);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+        (rc != RCL_RET_SERVICE_TAKE_FAILED))
+      {
+        return rc;
+      }
+      rc = _rclc_execute(handle, &executor->monitoring);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+      rc = _rclc_take_and_execute_remaining(executor, handle);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
 
-    case RCLC_GUARD_CONDITION:
-      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
-      // nothing to do
-      break;
+static
+rcl_ret_t
+_rclc_let_scheduling(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
 
-    default:
-      RCUTILS_LOG_DEBUG_NAMED(
-        ROS_PACKAGE_NAME, "Error in _rclc_take_new_data:wait_set unknwon handle type: %d",
-        handle->type);
-      return RCL_RET_ERROR;
-  }    // switch-case
+  // logical execution time
+  // 1. read all input
+  // 2. process
+  // 3. write data (*) data is written not at the end of all callbacks, but it will not be
+  //    processed by the callbacks 'in this round' because all input data is read in the
+  //    beginning and the incoming messages were copied.
+
+  // step 0: check for available input data from DDS queue
+  // complexity: O(n) where n denotes the number of handles
+  rc = _rclc_executor_collect_ready_handles(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+
+  // if the trigger condition is fullfilled, fetch data and execute
+  // complexity: O(r) where r denotes the number of ready handles
+  if (_rclc_executor_evaluate_trigger(executor)) {
+    // step 1: read input data. The data of the handles carried over from the previous
+    // spin has already been taken.
+    for (size_t i = executor->carried_over_size; i < executor->ready_list_size; i++) {
+      rc = _rclc_take_new_data(
+        &executor->handles[executor->ready_list[i]], &executor->wait_set,
+        &executor->monitoring);
+      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+        return rc;
+      }
+    }
+
+    // step 2:  process (execute) in the order of executor->dispatch_order
+    for (size_t i = 0; i < executor->ready_list_size; i++) {
+      if (_rclc_executor_dispatch_budget_exhausted(executor, i)) {
+        break;
+      }
+      rc = _rclc_execute(&executor->handles[executor->ready_list[i]], &executor->monitoring);
+      if (rc != RCL_RET_OK) {
+        return rc;
+      }
+    }
+  }
   return rc;
 }
 
-bool _rclc_check_handle_data_available(rclc_executor_handle_t * handle)
-{
-  RCL_CHECK_ARGUMENT_FOR_NULL(handle, false);
+/***
+ * earliest-deadline-first scheduling: the ready handles are sorted by their absolute deadline
+ * into executor->ready_list. Then new data is taken and the callbacks are executed in this
+ * order. Handles with equal deadline (and without deadline) keep the order of
+ * executor->dispatch_order.
+ */
+static
+rcl_ret_t
+_rclc_edf_scheduling(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t rc = RCL_RET_OK;
+  rcutils_time_point_value_t now;
+
+  rc = _rclc_executor_collect_ready_handles(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  if (!_rclc_executor_evaluate_trigger(executor)) {
+    return RCL_RET_OK;
+  }
+
+  // release time of all handles with new data
+  rc = rcutils_steady_time_now(&now);
+  if (rc != RCUTILS_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_edf_scheduling, rcutils_steady_time_now);
+    return RCL_RET_ERROR;
+  }
 
-  switch (handle->type) {
-    case RCLC_ACTION_CLIENT:
-      if (handle->action_client->feedback_available ||
-        handle->action_client->status_available ||
-        handle->action_client->goal_response_available ||
-        handle->action_client->cancel_response_available ||
-        handle->action_client->result_response_available)
+  // sort the ready list by absolute deadline (stable insertion sort). Handles carried over
+  // from the previous spin stay first and keep their absolute deadline.
+  for (size_t i = executor->carried_over_size; i < executor->ready_list_size; i++) {
+    size_t handle_index = executor->ready_list[i];
+    rclc_executor_handle_t * handle = &executor->handles[handle_index];
+    rcutils_time_point_value_t release_time = now;
+    if ((handle->type == RCLC_TIMER) && handle->data_available) {
+      // release time of a timer is its scheduled call time
+      int64_t time_until_next_call = 0;
+      if (rcl_timer_get_time_until_next_call(handle->timer, &time_until_next_call) ==
+        RCL_RET_OK)
       {
-        return true;
+        release_time = now + time_until_next_call;
       }
-      break;
+    }
+    handle->absolute_deadline = (handle->deadline > 0) ?
+      (release_time + handle->deadline) : INT64_MAX;
+
+    size_t j = i;
+    for (; (j > executor->carried_over_size) &&
+      (executor->handles[executor->ready_list[j - 1]].absolute_deadline >
+      handle->absolute_deadline); j--)
+    {
+      executor->ready_list[j] = executor->ready_list[j - 1];
+    }
+    executor->ready_list[j] = handle_index;
+  }
 
-    case RCLC_ACTION_SERVER:
-      if (handle->action_server->goal_request_available ||
-        handle->action_server->cancel_request_available ||
-        handle->action_server->goal_expired_available ||
-        handle->action_server->result_request_available ||
-        handle->action_server->goal_ended)
-      {
-        return true;
-      }
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    if (_rclc_executor_dispatch_budget_exhausted(executor, i)) {
       break;
-
-    default:
-      if (handle->data_available) {
-        return true;
+    }
+    rclc_executor_handle_t * handle = &executor->handles[executor->ready_list[i]];
+    rc = _rclc_take_new_data(handle, &executor->wait_set, &executor->monitoring);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+      (rc != RCL_RET_SERVICE_TAKE_FAILED))
+    {
+      return rc;
+    }
+    rc = _rclc_execute(handle, &executor->monitoring);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    // the absolute deadline belongs to the job released in this spin, i.e. the first message.
+    // Further messages taken by _rclc_take_and_execute_remaining were released later.
+    if (handle->deadline > 0) {
+      rcutils_time_point_value_t finish_time;
+      if ((rcutils_steady_time_now(&finish_time) == RCUTILS_RET_OK) &&
+        (finish_time > handle->absolute_deadline))
+      {
+        handle->deadline_misses++;
+        executor->deadline_misses++;
       }
-      break;
-  }  // switch-case
-
-  return false;
+    }
+    rc = _rclc_take_and_execute_remaining(executor, handle);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+  }
+  return rc;
 }
 
 /***
- * operates on executor->handles[i] object
- * - calls every callback of each object depending on its type
+ * returns true, if handle \p a is processed before handle \p b: with priority scheduling
+ * the handle with the higher priority, otherwise (and for equal priority) the handle, which
+ * was added first.
  */
-
-// todo change parametes (rclc_executor_handle_t * handle)
-
 static
-rcl_ret_t
-_rclc_execute(rclc_executor_handle_t * handle)
+bool
+_rclc_executor_handle_precedes(
+  const rclc_executor_t * executor,
+  const rclc_executor_handle_t * a,
+  const rclc_executor_handle_t * b)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
-  rcl_ret_t rc = RCL_RET_OK;
-  bool invoke_callback = false;
-
-  // determine, if callback shall be called
-  if (handle->invocation == ON_NEW_DATA &&
-    _rclc_check_handle_data_available(handle))
-  {
-    invoke_callback = true;
+  if (executor->priority_scheduling && (a->priority != b->priority)) {
+    return a->priority > b->priority;
   }
+  return a->registration_number < b->registration_number;
+}
 
-  if (handle->invocation == ALWAYS) {
-    invoke_callback = true;
+/***
+ * computes the order, in which the handles are processed: by default in the order in which
+ * they were added, with priority scheduling sorted by priority (highest first). Handles with
+ * equal priority keep the order in which they were added. Because removed handles are replaced
+ * by the last handle, the handle array is almost sorted and the insertion sort is fast.
+ *
+ * This is only necessary, if handles have been added or removed or a priority has changed.
+ */
+static
+void
+_rclc_executor_update_dispatch_order(rclc_executor_t * executor)
+{
+  size_t * order = executor->dispatch_order;
+  for (size_t i = 0; i < executor->index; i++) {
+    size_t j = i;
+    for (; (j > 0) &&
+      _rclc_executor_handle_precedes(executor, &executor->handles[i],
+      &executor->handles[order[j - 1]]); j--)
+    {
+      order[j] = order[j - 1];
+    }
+    order[j] = i;
   }
 
-  // execute callback
-  if (invoke_callback) {
+  // hot data of the handles in dispatch order
+  rcl_wait_set_t * wait_set = &executor->wait_set;
+  for (size_t i = 0; i < executor->index; i++) {
+    rclc_executor_handle_t * handle = &executor->handles[order[i]];
+    rclc_executor_handle_hot_t * hot = &executor->hot_handles[i];
+    hot->handle_index = order[i];
+    hot->always = (handle->invocation == ALWAYS);
     switch (handle->type) {
       case RCLC_SUBSCRIPTION:
-        if (handle->data_available) {
-          handle->subscription_callback(handle->data);
-        } else {
-          handle->subscription_callback(NULL);
-        }
-        break;
-
       case RCLC_SUBSCRIPTION_WITH_CONTEXT:
-        if (handle->data_available) {
-          handle->subscription_callback_with_context(
-            handle->data,
-            handle->callback_context);
-        } else {
-          handle->subscription_callback_with_context(
-            NULL,
-            handle->callback_context);
-        }
+      case RCLC_SUBSCRIPTION_BATCH:
+      case RCLC_SUBSCRIPTION_LOANED:
+      case RCLC_SUBSCRIPTION_SERIALIZED:
+      case RCLC_SUBSCRIPTION_RING:
+        hot->wait_set_entry = (const void * const *) &wait_set->subscriptions[handle->index];
         break;
-
       case RCLC_TIMER:
-        // case RCLC_TIMER_WITH_CONTEXT:
-        rc = rcl_timer_call(handle->timer);
-
-        // cancled timer are not handled, return success
-        if (rc == RCL_RET_TIMER_CANCELED) {
-          rc = RCL_RET_OK;
-          break;
-        }
-
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_execute, rcl_timer_call);
-          return rc;
-        }
+        hot->wait_set_entry = (const void * const *) &wait_set->timers[handle->index];
+        break;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        hot->wait_set_entry = (const void * const *) &wait_set->clients[handle->index];
         break;
-
       case RCLC_SERVICE:
       case RCLC_SERVICE_WITH_REQUEST_ID:
       case RCLC_SERVICE_WITH_CONTEXT:
-        // differentiate user-side service types
-        switch (handle->type) {
-          case RCLC_SERVICE:
-            handle->service_callback(
-              handle->data,
-              handle->data_response_msg);
-            break;
-          case RCLC_SERVICE_WITH_REQUEST_ID:
-            handle->service_callback_with_reqid(
-              handle->data,
-              &handle->req_id,
-              handle->data_response_msg);
-            break;
-          case RCLC_SERVICE_WITH_CONTEXT:
-            handle->service_callback_with_context(
-              handle->data,
-              handle->data_response_msg,
-              handle->callback_context);
-            break;
-          default:
-            break;  // flow can't reach here
-        }
-        // handle rcl-side services
-        rc = rcl_send_response(handle->service, &handle->req_id, handle->data_response_msg);
-        if (rc != RCL_RET_OK) {
-          PRINT_RCLC_ERROR(rclc_execute, rcl_send_response);
-          return rc;
-        }
-        break;
-
-      case RCLC_CLIENT:
-        handle->client_callback(handle->data);
-        break;
-
-      case RCLC_CLIENT_WITH_REQUEST_ID:
-        handle->client_callback_with_reqid(handle->data, &handle->req_id);
+        hot->wait_set_entry = (const void * const *) &wait_set->services[handle->index];
         break;
-
-      // case RCLC_CLIENT_WITH_CONTEXT:   //TODO
-      //   break;
-
       case RCLC_GUARD_CONDITION:
-        handle->gc_callback();
+        hot->wait_set_entry = (const void * const *) &wait_set->guard_conditions[handle->index];
         break;
-
-      // case RCLC_GUARD_CONDITION_WITH_CONTEXT:  //TODO
-      //   break;
-
-      case RCLC_ACTION_CLIENT:
-        // TODO(pablogs9): Handle action client status
-        if (handle->action_client->goal_response_available) {
-          // Handle action client goal response messages
-          //
-          // Pre-condition:
-          // - goal in action_client->used_goal_handles list
-          // - goal->available_goal_response = true
-          //
-          // Post-condition:
-          // - goal->available_goal_response = false
-          rclc_action_goal_handle_t * goal_handle;
-          while (goal_handle =
-            rclc_action_find_first_handle_with_goal_response(handle->action_client),
-            NULL != goal_handle)
-          {
-            // Set post-condition
-            goal_handle->available_goal_response = false;
-            handle->action_client->goal_callback(
-              goal_handle, goal_handle->goal_accepted,
-              handle->callback_context);
-            if (!goal_handle->goal_accepted ||
-              RCL_RET_OK != rclc_action_send_result_request(goal_handle))
-            {
-              rclc_action_remove_used_goal_handle(handle->action_client, goal_handle);
-            } else {
-              goal_handle->status = GOAL_STATE_ACCEPTED;
-            }
-          }
-        }
-        if (handle->action_client->feedback_available) {
-          rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
-            goal_handle = goal_handle->next)
-          {
-            if (goal_handle->available_feedback) {
-              goal_handle->available_feedback = false;
-
-              if (handle->action_client->feedback_callback != NULL) {
-                handle->action_client->feedback_callback(
-                  goal_handle,
-                  handle->action_client->ros_feedback,
-                  handle->callback_context);
-              }
-            }
-          }
-        }
-        if (handle->action_client->cancel_response_available) {
-          rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_client->used_goal_handles; NULL != goal_handle;
-            goal_handle = goal_handle->next)
-          {
-            if (goal_handle->available_cancel_response) {
-              goal_handle->available_cancel_response = false;
-
-              if (handle->action_client->cancel_callback != NULL) {
-                handle->action_client->cancel_callback(
-                  goal_handle,
-                  goal_handle->goal_cancelled,
-                  handle->callback_context);
-              }
-            }
-          }
-        }
-        if (handle->action_client->result_response_available) {
-          // Handle action client result response messages
-          //
-          // Pre-condition:
-          // - goal in action_client->used_goal_handles list
-          // - goal->available_result_response = true
-          //
-          // Post-condition:
-          // - goal->available_result_response = false
-          // - goal deleted from action_client->used_goal_handles list
-          rclc_action_goal_handle_t * goal_handle;
-          while (goal_handle =
-            rclc_action_find_first_handle_with_result_response(handle->action_client),
-            NULL != goal_handle)
-          {
-            // Set first post-condition:
-            goal_handle->available_result_response = false;
-            handle->action_client->result_callback(
-              goal_handle,
-              handle->action_client->ros_result_response,
-              handle->callback_context);
-
-            // Set second post-condition
-            rclc_action_remove_used_goal_handle(handle->action_client, goal_handle);
-          }
-        }
+      default:
+        // action client or action server
+        hot->wait_set_entry = NULL;
         break;
+    }
+    // the ready list and the deferred handles of the previous spin are not valid any more
+    handle->data_available = false;
+    handle->deferred = false;
+  }
+  executor->ready_list_size = 0;
+  executor->deferred_list_size = 0;
+  executor->carried_over_size = 0;
+  executor->deferred_runnable = false;
+  // the bitmasks of trigger expressions and deadline triggers refer to positions in the
+  // handle array
+  _rclc_executor_compile_trigger(executor);
+  executor->dispatch_order_is_valid = true;
+}
+
+/***
+ * sorts the rcl-handles of executor->handles by type into the array
+ * executor->wait_set_entities.entities and assigns the index of each handle
+ * in the corresponding array of the wait_set (wait_set->subscriptions[index], ...).
+ *
+ * This is only necessary, if handles have been added or removed, because
+ * _rclc_executor_fill_wait_set adds the rcl-handles in the same order to the
+ * wait_set in every spin.
+ */
+static
+rcl_ret_t
+_rclc_executor_update_wait_set_entities(rclc_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rclc_executor_wait_set_entities_t * ws_entities = &executor->wait_set_entities;
+  RCL_CHECK_ARGUMENT_FOR_NULL(ws_entities->entities, RCL_RET_INVALID_ARGUMENT);
 
+  ws_entities->number_of_subscriptions = 0;
+  ws_entities->number_of_timers = 0;
+  ws_entities->number_of_clients = 0;
+  ws_entities->number_of_services = 0;
+  ws_entities->number_of_guard_conditions = 0;
+  ws_entities->number_of_actions = 0;
+
+  // first pass: count the handles per type
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    switch (executor->handles[i].type) {
+      case RCLC_SUBSCRIPTION:
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      case RCLC_SUBSCRIPTION_BATCH:
+      case RCLC_SUBSCRIPTION_LOANED:
+      case RCLC_SUBSCRIPTION_SERIALIZED:
+      case RCLC_SUBSCRIPTION_RING:
+        ws_entities->number_of_subscriptions++;
+        break;
+      case RCLC_TIMER:
+        // case RCLC_TIMER_WITH_CONTEXT:
+        ws_entities->number_of_timers++;
+        break;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        // case RCLC_CLIENT_WITH_CONTEXT:
+        ws_entities->number_of_clients++;
+        break;
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        ws_entities->number_of_services++;
+        break;
+      case RCLC_GUARD_CONDITION:
+        // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+        ws_entities->number_of_guard_conditions++;
+        break;
+      case RCLC_ACTION_CLIENT:
       case RCLC_ACTION_SERVER:
-        if (handle->action_server->goal_ended) {
-          // Handle action server terminated goals (succeeded, canceled or aborted)
-          //
-          // Pre-condition:
-          // - goal in action_server->used_goal_handles list
-          // - goal->status > GOAL_STATE_CANCELING
-          //
-          // Post-condition:
-          // - goal deleted from action_server->used_goal_handles list
-          rclc_action_goal_handle_t * goal_handle;
-          while (goal_handle =
-            rclc_action_find_first_terminated_handle(handle->action_server),
-            NULL != goal_handle)
-          {
-            // Set post-condition
-            rclc_action_remove_used_goal_handle(goal_handle->action_server, goal_handle);
-          }
-          handle->action_server->goal_ended = false;
-        }
-        if (handle->action_server->goal_request_available) {
-          // Handle action server goal request messages
-          //
-          // Pre-condition:
-          // - goal in action_server->used_goal_handles list
-          // - goal->status = GOAL_STATE_UNKNOWN
-          //
-          // Accepted post-condition:
-          // - goal->status = GOAL_STATE_ACCEPTED
-          // Rejected/Error post-condition:
-          // - goal deleted from action_server->used_goal_handles list
-          rclc_action_goal_handle_t * goal_handle;
-          while (goal_handle =
-            rclc_action_find_first_handle_by_status(handle->action_server, GOAL_STATE_UNKNOWN),
-            NULL != goal_handle)
-          {
-            rcl_ret_t ret = handle->action_server->goal_callback(
-              goal_handle,
-              handle->callback_context);
-            switch (ret) {
-              case RCL_RET_ACTION_GOAL_ACCEPTED:
-                rclc_action_server_response_goal_request(goal_handle, true);
-                // Set accepted post-condition
-                goal_handle->status = GOAL_STATE_ACCEPTED;
-                break;
-              case RCL_RET_ACTION_GOAL_REJECTED:
-              default:
-                rclc_action_server_response_goal_request(goal_handle, false);
-                // Set rejected/error post-condition
-                rclc_action_remove_used_goal_handle(handle->action_server, goal_handle);
-                break;
-            }
-          }
-          handle->action_server->goal_request_available = false;
-        }
-        if (handle->action_server->cancel_request_available) {
-          rclc_action_goal_handle_t * goal_handle;
-          for (goal_handle = handle->action_server->used_goal_handles; NULL != goal_handle;
-            goal_handle = goal_handle->next)
-          {
-            if (GOAL_STATE_CANCELING == goal_handle->status) {
-              goal_handle->goal_cancelled =
-                handle->action_server->cancel_callback(goal_handle, handle->callback_context);
-              if (goal_handle->goal_cancelled) {
-                rclc_action_server_goal_cancel_accept(goal_handle);
-              } else {
-                rclc_action_server_goal_cancel_reject(
-                  handle->action_server, CANCEL_STATE_REJECTED,
-                  goal_handle->cancel_request_header);
-                goal_handle->status = GOAL_STATE_EXECUTING;
-              }
-            }
-          }
-          handle->action_server->cancel_request_available = false;
-        }
+        ws_entities->number_of_actions++;
         break;
-
       default:
         RCUTILS_LOG_DEBUG_NAMED(
-          ROS_PACKAGE_NAME, "Error in _rclc_execute: unknwon handle type: %d",
-          handle->type);
+          ROS_PACKAGE_NAME, "Error: unknown handle type: %d",
+          executor->handles[i].type);
+        PRINT_RCLC_ERROR(rclc_executor_prepare, rcl_wait_set_add_unknown_handle);
         return RCL_RET_ERROR;
-    }   // switch-case
+    }
   }
 
-  return rc;
-}
+  // second pass: sort rcl-handles by type and save index in wait_set
+  // the actions are added at last, because they add subscriptions, clients, services
+  // and timers to the wait_set, which are not managed by the executor handles.
+  const void ** subscriptions = ws_entities->entities;
+  const void ** timers = subscriptions + ws_entities->number_of_subscriptions;
+  const void ** clients = timers + ws_entities->number_of_timers;
+  const void ** services = clients + ws_entities->number_of_clients;
+  const void ** guard_conditions = services + ws_entities->number_of_services;
+  const void ** actions = guard_conditions + ws_entities->number_of_guard_conditions;
+  size_t sub_index = 0, timer_index = 0, client_index = 0, service_index = 0,
+    gc_index = 0, action_index = 0;
 
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rclc_executor_handle_t * handle = &executor->handles[i];
+    switch (handle->type) {
+      case RCLC_SUBSCRIPTION:
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      case RCLC_SUBSCRIPTION_BATCH:
+      case RCLC_SUBSCRIPTION_LOANED:
+      case RCLC_SUBSCRIPTION_SERIALIZED:
+      case RCLC_SUBSCRIPTION_RING:
+        subscriptions[sub_index] = handle->subscription;
+        handle->index = sub_index++;
+        break;
+      case RCLC_TIMER:
+        timers[timer_index] = handle->timer;
+        handle->index = timer_index++;
+        break;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        clients[client_index] = handle->client;
+        handle->index = client_index++;
+        break;
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        services[service_index] = handle->service;
+        handle->index = service_index++;
+        break;
+      case RCLC_GUARD_CONDITION:
+        guard_conditions[gc_index] = handle->gc;
+        handle->index = gc_index++;
+        break;
+      default:
+        // action client or action server, index is assigned in rcl_wait_set_add_*
+        actions[action_index++] = handle;
+        break;
+    }
+  }
+  return RCL_RET_OK;
+}
 
+/***
+ * clears the wait_set and adds all rcl-handles of executor->wait_set_entities.
+ *
+ * rcl_wait() sets the entries of all handles without new data to NULL, therefore
+ * the wait_set needs to be refilled before every call of rcl_wait(). Because
+ * the rcl-handles are already sorted by type, the index of each handle in the
+ * wait_set is the same as computed in _rclc_executor_update_wait_set_entities.
+ */
 static
 rcl_ret_t
-_rclc_default_scheduling(rclc_executor_t * executor)
+_rclc_executor_fill_wait_set(rclc_executor_t * executor)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t rc = RCL_RET_OK;
+  rcl_wait_set_t * wait_set = &executor->wait_set;
+  rclc_executor_wait_set_entities_t * ws_entities = &executor->wait_set_entities;
+  const void ** entity = ws_entities->entities;
 
-  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
-    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
+  // set rmw fields to NULL
+  rc = rcl_wait_set_clear(wait_set);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_clear);
+    return rc;
+  }
+
+  for (size_t i = 0; i < ws_entities->number_of_subscriptions; i++, entity++) {
+    rc = rcl_wait_set_add_subscription(wait_set, *entity, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_subscription);
       return rc;
     }
   }
-  // if the trigger condition is fullfilled, fetch data and execute
-  if (executor->trigger_function(
-      executor->handles, executor->max_handles,
-      executor->trigger_object))
-  {
-    // take new input data from DDS-queue and execute the corresponding callback of the handle
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_take_new_data(&executor->handles[i], &executor->wait_set);
-      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
-        (rc != RCL_RET_SERVICE_TAKE_FAILED))
-      {
+  for (size_t i = 0; i < ws_entities->number_of_timers; i++, entity++) {
+    rc = rcl_wait_set_add_timer(wait_set, *entity, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_timer);
+      return rc;
+    }
+  }
+  for (size_t i = 0; i < ws_entities->number_of_clients; i++, entity++) {
+    rc = rcl_wait_set_add_client(wait_set, *entity, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_client);
+      return rc;
+    }
+  }
+  for (size_t i = 0; i < ws_entities->number_of_services; i++, entity++) {
+    rc = rcl_wait_set_add_service(wait_set, *entity, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_service);
+      return rc;
+    }
+  }
+  for (size_t i = 0; i < ws_entities->number_of_guard_conditions; i++, entity++) {
+    rc = rcl_wait_set_add_guard_condition(wait_set, *entity, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_guard_condition);
+      return rc;
+    }
+  }
+  for (size_t i = 0; i < ws_entities->number_of_actions; i++, entity++) {
+    rclc_executor_handle_t * handle = (rclc_executor_handle_t *) *entity;
+    if (handle->type == RCLC_ACTION_CLIENT) {
+      rc = rcl_action_wait_set_add_action_client(
+        wait_set, &handle->action_client->rcl_handle, &handle->index, NULL);
+      if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_client);
         return rc;
       }
-      rc = _rclc_execute(&executor->handles[i]);
+    } else {
+      rc = rcl_action_wait_set_add_action_server(
+        wait_set, &handle->action_server->rcl_handle, &handle->index);
       if (rc != RCL_RET_OK) {
+        PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_server);
         return rc;
       }
     }
@@ -1713,88 +4065,309 @@ _rclc_default_scheduling(rclc_executor_t * executor)
   return rc;
 }
 
+rcl_ret_t
+rclc_executor_prepare(rclc_executor_t * executor)
+{
+  rcl_ret_t rc = RCL_RET_OK;
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "executor_prepare");
+
+  // initialize wait_set if
+  // (1) this is the first invocation of executor_spin_some()
+  // (2) executor_add_timer() or executor_add_subscription() has been called.
+  //     i.e. a new timer or subscription has been added to the Executor.
+  if (!rcl_wait_set_is_valid(&executor->wait_set)) {
+    // calling wait_set on zero_initialized wait_set multiple times is ok.
+    rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_fini);
+    }
+    // initialize wait_set
+    executor->wait_set = rcl_get_zero_initialized_wait_set();
+    // create sufficient memory space for all handles in the wait_set
+    // multi-threaded executor: one additional guard condition for the worker threads
+    size_t number_of_guard_conditions = executor->info.number_of_guard_conditions;
+    if (NULL != executor->worker_pool) {
+      number_of_guard_conditions++;
+    }
+    rc = rcl_wait_set_init(
+      &executor->wait_set, executor->info.number_of_subscriptions,
+      number_of_guard_conditions, executor->info.number_of_timers,
+      executor->info.number_of_clients, executor->info.number_of_services,
+      executor->info.number_of_events,
+      executor->context,
+      *executor->allocator);
+
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_init);
+      return rc;
+    }
+    executor->wait_set_entities_is_valid = false;
+  }
+
+  // the set of handles has changed: update the rcl-handles of the wait_set.
+  // After removing handles, the wait_set is still large enough and is not re-initialized.
+  if (!executor->wait_set_entities_is_valid) {
+    rc = _rclc_executor_update_wait_set_entities(executor);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    executor->wait_set_entities_is_valid = true;
+    executor->dispatch_order_is_valid = false;
+  }
+
+  if (!executor->dispatch_order_is_valid) {
+    _rclc_executor_update_dispatch_order(executor);
+  }
+
+  return rc;
+}
+
+/***
+ * Multi-threaded executor: adds all handles, which are not executed by a worker thread,
+ * and the guard condition of the worker threads to the wait_set. The wait_set index of
+ * each added handle is stored in handle->index, all other handles get the invalid
+ * index max_handles.
+ */
+static
+rcl_ret_t
+_rclc_executor_fill_wait_set_multi_threaded(rclc_executor_t * executor)
+{
+  rcl_ret_t rc = RCL_RET_OK;
+  rcl_wait_set_t * wait_set = &executor->wait_set;
+
+  rc = rcl_wait_set_clear(wait_set);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_clear);
+    return rc;
+  }
+
+  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
+    rclc_executor_handle_t * handle = &executor->handles[i];
+    if (rclc_executor_worker_pool_is_busy(executor->worker_pool, handle)) {
+      handle->index = executor->max_handles;
+      continue;
+    }
+    switch (handle->type) {
+      case RCLC_SUBSCRIPTION:
+      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+      case RCLC_SUBSCRIPTION_BATCH:
+      case RCLC_SUBSCRIPTION_LOANED:
+      case RCLC_SUBSCRIPTION_SERIALIZED:
+      case RCLC_SUBSCRIPTION_RING:
+        rc = rcl_wait_set_add_subscription(wait_set, handle->subscription, &handle->index);
+        break;
+      case RCLC_TIMER:
+        // case RCLC_TIMER_WITH_CONTEXT:
+        rc = rcl_wait_set_add_timer(wait_set, handle->timer, &handle->index);
+        break;
+      case RCLC_CLIENT:
+      case RCLC_CLIENT_WITH_REQUEST_ID:
+        // case RCLC_CLIENT_WITH_CONTEXT:
+        rc = rcl_wait_set_add_client(wait_set, handle->client, &handle->index);
+        break;
+      case RCLC_SERVICE:
+      case RCLC_SERVICE_WITH_REQUEST_ID:
+      case RCLC_SERVICE_WITH_CONTEXT:
+        rc = rcl_wait_set_add_service(wait_set, handle->service, &handle->index);
+        break;
+      case RCLC_GUARD_CONDITION:
+        // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
+        rc = rcl_wait_set_add_guard_condition(wait_set, handle->gc, &handle->index);
+        break;
+      case RCLC_ACTION_CLIENT:
+        rc = rcl_action_wait_set_add_action_client(
+          wait_set, &handle->action_client->rcl_handle, &handle->index, NULL);
+        break;
+      case RCLC_ACTION_SERVER:
+        rc = rcl_action_wait_set_add_action_server(
+          wait_set, &handle->action_server->rcl_handle, &handle->index);
+        break;
+      default:
+        RCUTILS_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Error: unknown handle type: %d", handle->type);
+        rc = RCL_RET_ERROR;
+        break;
+    }
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add);
+      return rc;
+    }
+  }
+
+  rc = rcl_wait_set_add_guard_condition(wait_set, &executor->worker_guard_condition, NULL);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_guard_condition);
+  }
+  return rc;
+}
+
+/***
+ * Multi-threaded executor: new data is taken in the calling thread and the callbacks are
+ * dispatched to the worker threads. Handles, which are executed by a worker thread,
+ * are skipped. Action clients and action servers are executed in the calling thread.
+ * The busy flags are read without locking the pool, so that worker threads, which finish a
+ * callback, are not blocked while new data is taken. A handle, which is not busy, cannot
+ * become busy in between, because only the calling thread dispatches handles.
+ */
 static
 rcl_ret_t
-_rclc_let_scheduling(rclc_executor_t * executor)
+_rclc_multi_threaded_scheduling(rclc_executor_t * executor)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t rc = RCL_RET_OK;
+  bool execute_actions = false;
+
+  // snapshot of the handles, which are not executed by a worker thread
+  executor->ready_list_size = 0;
+  for (size_t i = 0; i < executor->index; i++) {
+    size_t handle_index = executor->dispatch_order[i];
+    if (!rclc_executor_worker_pool_is_busy(
+        executor->worker_pool, &executor->handles[handle_index]))
+    {
+      executor->ready_list[executor->ready_list_size++] = handle_index;
+    }
+  }
 
-  // logical execution time
-  // 1. read all input
-  // 2. process
-  // 3. write data (*) data is written not at the end of all callbacks, but it will not be
-  //    processed by the callbacks 'in this round' because all input data is read in the
-  //    beginning and the incoming messages were copied.
-
-  // step 0: check for available input data from DDS queue
-  // complexity: O(n) where n denotes the number of handles
-  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    rc = _rclc_check_for_new_data(&executor->handles[i], &executor->wait_set);
+  size_t ready_list_size = 0;
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    size_t handle_index = executor->ready_list[i];
+    rclc_executor_handle_t * handle = &executor->handles[handle_index];
+    if (handle->index >= executor->max_handles) {
+      // handle has been finished by a worker thread after the wait_set was filled
+      handle->data_available = false;
+      continue;
+    }
+    rc = _rclc_check_for_new_data(handle, &executor->wait_set);
     if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
       return rc;
     }
+    if ((handle->invocation == ALWAYS) || _rclc_check_handle_data_available(handle)) {
+      executor->ready_list[ready_list_size++] = handle_index;
+    }
   }
+  executor->ready_list_size = ready_list_size;
 
-  // if the trigger condition is fullfilled, fetch data and execute
-  // complexity: O(n) where n denotes the number of handles
-  if (executor->trigger_function(
-      executor->handles, executor->max_handles,
-      executor->trigger_object))
-  {
-    // step 1: read input data
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_take_new_data(&executor->handles[i], &executor->wait_set);
-      if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED)) {
-        return rc;
-      }
+  if (!_rclc_executor_evaluate_trigger(executor)) {
+    return RCL_RET_OK;
+  }
+
+  // take new data in the order of executor->dispatch_order, the ready_list keeps only the
+  // handles, which are executed
+  ready_list_size = 0;
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    size_t handle_index = executor->ready_list[i];
+    rclc_executor_handle_t * handle = &executor->handles[handle_index];
+    if ((handle->type == RCLC_ACTION_CLIENT) || (handle->type == RCLC_ACTION_SERVER)) {
+      execute_actions = true;
+      executor->ready_list[ready_list_size++] = handle_index;
+      continue;
+    }
+    rc = _rclc_take_new_data(handle, &executor->wait_set, &executor->monitoring);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+      (rc != RCL_RET_SERVICE_TAKE_FAILED))
+    {
+      return rc;
+    }
+    rc = RCL_RET_OK;
+    if ((handle->invocation == ALWAYS) || _rclc_check_handle_data_available(handle)) {
+      executor->ready_list[ready_list_size++] = handle_index;
+    }
+  }
+  executor->ready_list_size = ready_list_size;
+
+  for (size_t i = 0; i < executor->ready_list_size; i++) {
+    rclc_executor_handle_t * handle = &executor->handles[executor->ready_list[i]];
+    if ((handle->type == RCLC_ACTION_CLIENT) || (handle->type == RCLC_ACTION_SERVER)) {
+      continue;
+    }
+    rc = rclc_executor_worker_pool_dispatch(executor->worker_pool, handle);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_spin_some, rclc_executor_worker_pool_dispatch);
+      return rc;
     }
+  }
 
-    // step 2:  process (execute)
-    for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-      rc = _rclc_execute(&executor->handles[i]);
-      if (rc != RCL_RET_OK) {
-        return rc;
-      }
+  // action handles are never dispatched to worker threads
+  for (size_t i = 0; execute_actions && (i < executor->ready_list_size); i++) {
+    rclc_executor_handle_t * handle = &executor->handles[executor->ready_list[i]];
+    if ((handle->type != RCLC_ACTION_CLIENT) && (handle->type != RCLC_ACTION_SERVER)) {
+      continue;
+    }
+    rc = _rclc_take_new_data(handle, &executor->wait_set, &executor->monitoring);
+    if ((rc != RCL_RET_OK) && (rc != RCL_RET_SUBSCRIPTION_TAKE_FAILED) &&
+      (rc != RCL_RET_SERVICE_TAKE_FAILED))
+    {
+      return rc;
+    }
+    rc = _rclc_execute(handle, &executor->monitoring);
+    if (rc != RCL_RET_OK) {
+      return rc;
     }
   }
   return rc;
 }
 
+/***
+ * waits with rcl_wait for new data of the handles in the (filled) wait_set. With busy
+ * polling, rcl_wait is called with zero timeout until a handle is ready or the busy-poll
+ * window has elapsed, then it blocks for the remaining timeout.
+ */
+static
 rcl_ret_t
-rclc_executor_prepare(rclc_executor_t * executor)
+_rclc_executor_wait(rclc_executor_t * executor, int64_t timeout_ns)
 {
-  rcl_ret_t rc = RCL_RET_OK;
-  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "executor_prepare");
+  if ((executor->busy_poll_ns == 0) || (timeout_ns == 0)) {
+    return rcl_wait(&executor->wait_set, timeout_ns);
+  }
 
-  // initialize wait_set if
-  // (1) this is the first invocation of executor_spin_some()
-  // (2) executor_add_timer() or executor_add_subscription() has been called.
-  //     i.e. a new timer or subscription has been added to the Executor.
-  if (!rcl_wait_set_is_valid(&executor->wait_set)) {
-    // calling wait_set on zero_initialized wait_set multiple times is ok.
-    rcl_ret_t rc = rcl_wait_set_fini(&executor->wait_set);
-    if (rc != RCL_RET_OK) {
-      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_fini);
+  rcl_ret_t rc = RCL_RET_OK;
+  rclc_executor_busy_poll_statistics_t * statistics = &executor->busy_poll_statistics;
+  int64_t window = (int64_t) executor->busy_poll_ns;
+  if ((timeout_ns > 0) && (timeout_ns < window)) {
+    window = timeout_ns;
+  }
+  int64_t poll_start = rclc_monotonic_time_ns();
+  int64_t elapsed = 0;
+  while (true) {
+    rc = rcl_wait(&executor->wait_set, 0);
+    statistics->polls++;
+    if (rc != RCL_RET_TIMEOUT) {
+      if (rc == RCL_RET_OK) {
+        statistics->busy_poll_hits++;
+      }
+      return rc;
     }
-    // initialize wait_set
-    executor->wait_set = rcl_get_zero_initialized_wait_set();
-    // create sufficient memory space for all handles in the wait_set
-    rc = rcl_wait_set_init(
-      &executor->wait_set, executor->info.number_of_subscriptions,
-      executor->info.number_of_guard_conditions, executor->info.number_of_timers,
-      executor->info.number_of_clients, executor->info.number_of_services,
-      executor->info.number_of_events,
-      executor->context,
-      *executor->allocator);
-
+    elapsed = rclc_monotonic_time_ns() - poll_start;
+    if (elapsed >= window) {
+      break;
+    }
+    // rcl_wait has set all entries of the wait_set to NULL
+    rc = (executor->type == RCLC_EXECUTOR_MULTI_THREADED) ?
+      _rclc_executor_fill_wait_set_multi_threaded(executor) :
+      _rclc_executor_fill_wait_set(executor);
     if (rc != RCL_RET_OK) {
-      PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_init);
       return rc;
     }
   }
+  if (timeout_ns > 0) {
+    if (elapsed >= timeout_ns) {
+      return RCL_RET_TIMEOUT;
+    }
+    timeout_ns -= elapsed;
+  }
 
+  rc = (executor->type == RCLC_EXECUTOR_MULTI_THREADED) ?
+    _rclc_executor_fill_wait_set_multi_threaded(executor) :
+    _rclc_executor_fill_wait_set(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  statistics->blocking_waits++;
+  rc = rcl_wait(&executor->wait_set, timeout_ns);
+  if (rc == RCL_RET_OK) {
+    statistics->blocking_wakeups++;
+  }
   return rc;
 }
 
@@ -1802,158 +4375,87 @@ rcl_ret_t
 rclc_executor_spin_some(rclc_executor_t * executor, const uint64_t timeout_ns)
 {
   rcl_ret_t rc = RCL_RET_OK;
+  rcutils_time_point_value_t wait_start = 0;
+  rcutils_time_point_value_t wait_end = 0;
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "spin_some");
+  // rcl_wait blocks without timeout for negative values
+  int64_t wait_timeout_ns = (timeout_ns > (uint64_t) INT64_MAX) ? -1 : (int64_t) timeout_ns;
+  // handles deferred by the dispatch budget are executed without waiting, unless they wait
+  // for the trigger condition. With LET-semantics their data has already been taken, so
+  // rcl_wait would not return for them.
+  if ((executor->deferred_list_size > 0) && executor->deferred_runnable) {
+    wait_timeout_ns = 0;
+  }
 
   if (!rcl_context_is_valid(executor->context)) {
     PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_context_not_valid);
     return RCL_RET_ERROR;
   }
 
-  rclc_executor_prepare(executor);
-
-  // set rmw fields to NULL
-  rc = rcl_wait_set_clear(&executor->wait_set);
+  rc = rclc_executor_prepare(executor);
   if (rc != RCL_RET_OK) {
-    PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_clear);
     return rc;
   }
+  if (NULL != executor->monitoring.trace) {
+    rclc_executor_trace_record(
+      executor->monitoring.trace, RCLC_EXECUTOR_TRACE_SPIN_START, RCLC_EXECUTOR_TRACE_NO_HANDLE, 0);
+  }
 
-  // (jst3si) put in a sub-function - for improved readability
-  // add handles to wait_set
-  for (size_t i = 0; (i < executor->max_handles && executor->handles[i].initialized); i++) {
-    RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "wait_set_add_* %d", executor->handles[i].type);
-    switch (executor->handles[i].type) {
-      case RCLC_SUBSCRIPTION:
-      case RCLC_SUBSCRIPTION_WITH_CONTEXT:
-        // add subscription to wait_set and save index
-        rc = rcl_wait_set_add_subscription(
-          &executor->wait_set, executor->handles[i].subscription,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Subscription added to wait_set_subscription[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_subscription);
-          return rc;
-        }
-        break;
-
-      case RCLC_TIMER:
-        // case RCLC_TIMER_WITH_CONTEXT:
-        // add timer to wait_set and save index
-        rc = rcl_wait_set_add_timer(
-          &executor->wait_set, executor->handles[i].timer,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Timer added to wait_set_timers[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_timer);
-          return rc;
-        }
-        break;
-
-      case RCLC_SERVICE:
-      case RCLC_SERVICE_WITH_REQUEST_ID:
-      case RCLC_SERVICE_WITH_CONTEXT:
-        // add service to wait_set and save index
-        rc = rcl_wait_set_add_service(
-          &executor->wait_set, executor->handles[i].service,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Service added to wait_set_service[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_service);
-          return rc;
-        }
-        break;
-
-
-      case RCLC_CLIENT:
-      case RCLC_CLIENT_WITH_REQUEST_ID:
-        // case RCLC_CLIENT_WITH_CONTEXT:
-        // add client to wait_set and save index
-        rc = rcl_wait_set_add_client(
-          &executor->wait_set, executor->handles[i].client,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Client added to wait_set_client[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_client);
-          return rc;
-        }
-        break;
-
-      case RCLC_GUARD_CONDITION:
-        // case RCLC_GUARD_CONDITION_WITH_CONTEXT:
-        // add guard_condition to wait_set and save index
-        rc = rcl_wait_set_add_guard_condition(
-          &executor->wait_set, executor->handles[i].gc,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME, "Guard_condition added to wait_set_client[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_guard_condition);
-          return rc;
-        }
-        break;
-
-      case RCLC_ACTION_CLIENT:
-        // add action client to wait_set and save index
-        rc = rcl_action_wait_set_add_action_client(
-          &executor->wait_set, &executor->handles[i].action_client->rcl_handle,
-          &executor->handles[i].index, NULL);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Action client added to wait_set_action_clients[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_client);
-          return rc;
-        }
-        break;
-
-      case RCLC_ACTION_SERVER:
-        // add action server to wait_set and save index
-        rc = rcl_action_wait_set_add_action_server(
-          &executor->wait_set, &executor->handles[i].action_server->rcl_handle,
-          &executor->handles[i].index);
-        if (rc == RCL_RET_OK) {
-          RCUTILS_LOG_DEBUG_NAMED(
-            ROS_PACKAGE_NAME,
-            "Action server added to wait_set_action_servers[%ld]",
-            executor->handles[i].index);
-        } else {
-          PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_action_server);
-          return rc;
-        }
-        break;
-
-      default:
-        RCUTILS_LOG_DEBUG_NAMED(
-          ROS_PACKAGE_NAME, "Error: unknown handle type: %d",
-          executor->handles[i].type);
-        PRINT_RCLC_ERROR(rclc_executor_spin_some, rcl_wait_set_add_unknown_handle);
-        return RCL_RET_ERROR;
+  if (executor->type == RCLC_EXECUTOR_MULTI_THREADED) {
+    // report errors of callbacks executed by the worker threads since the last spin
+    rc = rclc_executor_worker_pool_get_error(executor->worker_pool);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    rc = _rclc_executor_fill_wait_set_multi_threaded(executor);
+    if (rc != RCL_RET_OK) {
+      return rc;
+    }
+    if (executor->monitoring.statistics_enabled) {
+      RCLC_UNUSED(rcutils_steady_time_now(&wait_start));
+    }
+    rc = _rclc_executor_wait(executor, wait_timeout_ns);
+    if (NULL != executor->monitoring.trace) {
+      rclc_executor_trace_record(
+        executor->monitoring.trace, RCLC_EXECUTOR_TRACE_WAIT_RETURN,
+        RCLC_EXECUTOR_TRACE_NO_HANDLE, rc);
     }
+    if (executor->monitoring.statistics_enabled) {
+      RCLC_UNUSED(rcutils_steady_time_now(&wait_end));
+    }
+    rc = _rclc_multi_threaded_scheduling(executor);
+    if (executor->monitoring.statistics_enabled) {
+      _rclc_executor_record_spin_statistics(executor, wait_start, wait_end);
+    }
+    return rc;
+  }
+
+  // add handles to wait_set
+  rc = _rclc_executor_fill_wait_set(executor);
+  if (rc != RCL_RET_OK) {
+    return rc;
   }
 
   // wait up to 'timeout_ns' to receive notification about which handles reveived
   // new data from DDS queue.
-  rc = rcl_wait(&executor->wait_set, timeout_ns);
-  RCLC_UNUSED(rc);
+  if (executor->monitoring.statistics_enabled) {
+    RCLC_UNUSED(rcutils_steady_time_now(&wait_start));
+  }
+  rc = _rclc_executor_wait(executor, wait_timeout_ns);
+  if (NULL != executor->monitoring.trace) {
+    rclc_executor_trace_record(
+      executor->monitoring.trace, RCLC_EXECUTOR_TRACE_WAIT_RETURN,
+      RCLC_EXECUTOR_TRACE_NO_HANDLE, rc);
+  }
+  if (executor->monitoring.statistics_enabled) {
+    RCLC_UNUSED(rcutils_steady_time_now(&wait_end));
+  }
 
+  if (executor->dispatch_budget_ns > 0) {
+    executor->dispatch_start_ns = rclc_monotonic_time_ns();
+    executor->budget_statistics.deferred_handles_last = 0;
+  }
   // based on semantics process input data
   switch (executor->data_comm_semantics) {
     case RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME:
@@ -1962,11 +4464,34 @@ rclc_executor_spin_some(rclc_executor_t * executor, const uint64_t timeout_ns)
     case RCLC_SEMANTICS_RCLCPP_EXECUTOR:
       rc = _rclc_default_scheduling(executor);
       break;
+    case RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST:
+      rc = _rclc_edf_scheduling(executor);
+      break;
     default:
       PRINT_RCLC_ERROR(rclc_executor_spin_some, unknown_semantics);
       return RCL_RET_ERROR;
   }
 
+  if (executor->monitoring.statistics_enabled) {
+    _rclc_executor_record_spin_statistics(executor, wait_start, wait_end);
+  }
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_spin_some_with_budget(
+  rclc_executor_t * executor,
+  const uint64_t timeout_ns,
+  const uint64_t budget_ns)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  uint64_t default_budget_ns = executor->dispatch_budget_ns;
+  rcl_ret_t rc = rclc_executor_set_dispatch_budget(executor, budget_ns);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  rc = rclc_executor_spin_some(executor, timeout_ns);
+  executor->dispatch_budget_ns = default_budget_ns;
   return rc;
 }
 
@@ -1980,7 +4505,12 @@ rclc_executor_spin(rclc_executor_t * executor)
     "INFO: rcl_wait timeout %ld ms",
     ((executor->timeout_ns / 1000) / 1000));
   while (true) {
-    ret = rclc_executor_spin_some(executor, executor->timeout_ns);
+    uint64_t timeout_ns = executor->timeout_ns;
+    ret = rclc_executor_get_wait_timeout(executor, &timeout_ns);
+    if (ret != RCL_RET_OK) {
+      return ret;
+    }
+    ret = rclc_executor_spin_some(executor, timeout_ns);
     if (!((ret == RCL_RET_OK) || (ret == RCL_RET_TIMEOUT))) {
       RCL_SET_ERROR_MSG("rclc_executor_spin_some error");
       return ret;
@@ -1997,33 +4527,84 @@ rclc_executor_spin(rclc_executor_t * executor)
  rclc_executor_spin_period implements the endless while-loop. The unit test covers only
  rclc_executor_spin_period_.
 */
+/***
+ * records the jitter of a period, i.e. the delay of the start of the spin after its
+ * scheduled time point
+ */
+static
+void
+_rclc_executor_record_period_statistics(rclc_executor_t * executor, int64_t jitter)
+{
+  rclc_executor_period_statistics_t * statistics = &executor->period_statistics;
+  if ((statistics->periods == 0) || (jitter < statistics->jitter_min_ns)) {
+    statistics->jitter_min_ns = jitter;
+  }
+  if ((statistics->periods == 0) || (jitter > statistics->jitter_max_ns)) {
+    statistics->jitter_max_ns = jitter;
+  }
+  statistics->periods++;
+  statistics->jitter_last_ns = jitter;
+  statistics->jitter_total_ns += jitter;
+}
+
 rcl_ret_t
 rclc_executor_spin_one_period(rclc_executor_t * executor, const uint64_t period)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   rcl_ret_t ret = RCL_RET_OK;
-  rcutils_time_point_value_t end_time_point;
-  rcutils_duration_value_t sleep_time;
 
+  int64_t start_time_point = rclc_monotonic_time_ns();
   if (executor->invocation_time == 0) {
-    ret = rcutils_system_time_now(&executor->invocation_time);
-    RCLC_UNUSED(ret);
+    executor->invocation_time = start_time_point;
   }
+  _rclc_executor_record_period_statistics(
+    executor, start_time_point - executor->invocation_time);
+
   ret = rclc_executor_spin_some(executor, executor->timeout_ns);
   if (!((ret == RCL_RET_OK) || (ret == RCL_RET_TIMEOUT))) {
     RCL_SET_ERROR_MSG("rclc_executor_spin_some error");
     return ret;
   }
-  // sleep UNTIL next invocation time point = invocation_time + period
-  ret = rcutils_system_time_now(&end_time_point);
-  sleep_time = (executor->invocation_time + period) - end_time_point;
-  if (sleep_time > 0) {
-    rclc_sleep_ms(sleep_time / 1000000);
+
+  // next invocation time point = invocation_time + period
+  int64_t next_time_point = executor->invocation_time + (int64_t) period;
+  int64_t end_time_point = rclc_monotonic_time_ns();
+  if (end_time_point > next_time_point) {
+    executor->period_statistics.overruns++;
+    if ((executor->period_overrun_policy == RCLC_PERIOD_OVERRUN_SKIP) && (period > 0)) {
+      // continue with the first time point of the schedule after end_time_point
+      int64_t missed = (end_time_point - executor->invocation_time) / (int64_t) period;
+      executor->period_statistics.skipped_periods += (uint64_t) missed;
+      next_time_point = executor->invocation_time + (missed + 1) * (int64_t) period;
+    }
   }
-  executor->invocation_time += period;
+  // sleep UNTIL the next invocation time point, returns immediately after an overrun
+  rclc_sleep_until_ns(next_time_point);
+  executor->invocation_time = next_time_point;
   return ret;
 }
 
+rcl_ret_t
+rclc_executor_set_period_overrun_policy(
+  rclc_executor_t * executor,
+  rclc_executor_period_overrun_policy_t policy)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  executor->period_overrun_policy = policy;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_get_period_statistics(
+  const rclc_executor_t * executor,
+  rclc_executor_period_statistics_t * statistics)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  *statistics = executor->period_statistics;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rclc_executor_spin_period(rclc_executor_t * executor, const uint64_t period)
 {
@@ -2049,9 +4630,39 @@ rclc_executor_set_trigger(
   RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
   executor->trigger_function = trigger_function;
   executor->trigger_object = trigger_object;
+  _rclc_executor_compile_trigger(executor);
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rclc_executor_set_trigger_expression(
+  rclc_executor_t * executor,
+  rclc_trigger_expression_t * expression)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(expression, RCL_RET_INVALID_ARGUMENT);
+  if (expression->words < executor->ready_bitmap_words) {
+    RCL_SET_ERROR_MSG("trigger expression was initialized for less handles than the executor");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  return rclc_executor_set_trigger(executor, rclc_executor_trigger_expression, expression);
+}
+
+rcl_ret_t
+rclc_executor_set_trigger_deadline(
+  rclc_executor_t * executor,
+  rclc_trigger_deadline_t * trigger)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(trigger, RCL_RET_INVALID_ARGUMENT);
+  if (trigger->words < executor->ready_bitmap_words) {
+    RCL_SET_ERROR_MSG("deadline trigger was initialized for less handles than the executor");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  trigger->waiting = false;
+  return rclc_executor_set_trigger(executor, rclc_executor_trigger_deadline, trigger);
+}
+
 bool rclc_executor_trigger_all(rclc_executor_handle_t * handles, unsigned int size, void * obj)
 {
   RCL_CHECK_FOR_NULL_WITH_MSG(handles, "handles is NULL", return false);
@@ -2119,3 +4730,74 @@ bool rclc_executor_trigger_always(rclc_executor_handle_t * handles, unsigned int
   RCLC_UNUSED(obj);
   return true;
 }
+
+bool rclc_executor_trigger_expression(
+  rclc_executor_handle_t * handles, unsigned int size,
+  void * obj)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(handles, "handles is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(obj, "trigger expression is NULL", return false);
+  const rclc_trigger_expression_t * expression = (const rclc_trigger_expression_t *) obj;
+  // called directly and not by the executor: the rcl-handles are searched in handles
+  for (size_t g = 0; g < expression->size; g++) {
+    const rclc_trigger_group_t * group = &expression->groups[g];
+    size_t ready_count = 0;
+    for (size_t i = 0; i < group->size; i++) {
+      for (unsigned int j = 0; (j < size) && handles[j].initialized; j++) {
+        if (rclc_executor_handle_get_ptr(&handles[j]) == group->rcl_handles[i]) {
+          if (_rclc_check_handle_data_available(&handles[j])) {
+            ready_count++;
+          }
+          break;
+        }
+      }
+    }
+    bool fulfilled = (group->op == RCLC_TRIGGER_ALL) ?
+      (ready_count == group->size) : (ready_count > 0);
+    if ((expression->op == RCLC_TRIGGER_ANY) && fulfilled) {
+      return true;
+    }
+    if ((expression->op == RCLC_TRIGGER_ALL) && !fulfilled) {
+      return false;
+    }
+  }
+  return (expression->op == RCLC_TRIGGER_ALL) && (expression->size > 0);
+}
+
+bool rclc_executor_trigger_deadline(
+  rclc_executor_handle_t * handles, unsigned int size,
+  void * obj)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(handles, "handles is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(obj, "deadline trigger is NULL", return false);
+  rclc_trigger_deadline_t * trigger = (rclc_trigger_deadline_t *) obj;
+  // called directly and not by the executor: the rcl-handles are searched in handles
+  size_t ready_count = 0;
+  for (size_t i = 0; i < trigger->inputs.size; i++) {
+    bool ready = false;
+    for (unsigned int j = 0; (j < size) && handles[j].initialized; j++) {
+      if (rclc_executor_handle_get_ptr(&handles[j]) == trigger->inputs.rcl_handles[i]) {
+        ready = _rclc_check_handle_data_available(&handles[j]);
+        break;
+      }
+    }
+    if (ready) {
+      ready_count++;
+    }
+  }
+  if (!_rclc_trigger_deadline_update(
+      trigger, ready_count == trigger->inputs.size, ready_count > 0))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < trigger->inputs.size; i++) {
+    trigger->fresh[i] = false;
+    for (unsigned int j = 0; (j < size) && handles[j].initialized; j++) {
+      if (rclc_executor_handle_get_ptr(&handles[j]) == trigger->inputs.rcl_handles[i]) {
+        trigger->fresh[i] = _rclc_check_handle_data_available(&handles[j]);
+        break;
+      }
+    }
+  }
+  return true;
+}
@@ -49,6 +49,14 @@ rclc_executor_handle_init(
   handle->data = NULL;
   handle->data_response_msg = NULL;
   handle->callback_context = NULL;
+  handle->data_msg_size = 0;
+  handle->data_capacity = 0;
+  handle->data_count = 0;
+  handle->data_fini = NULL;
+  handle->data_loaned = NULL;
+  handle->data_ring_head = 0;
+  handle->data_ring_size = 0;
+  handle->data_ring_snapshot = NULL;
 
   handle->subscription_callback = NULL;
   // because of union structure:
@@ -60,9 +68,57 @@ rclc_executor_handle_init(
   handle->index = max_handles;
   handle->initialized = false;
   handle->data_available = false;
+  handle->max_takes_per_spin = 1;
+  handle->priority = 0;
+  handle->registration_number = 0;
+  handle->deadline = 0;
+  handle->absolute_deadline = 0;
+  handle->deadline_misses = 0;
+  handle->wcet_ns = 0;
+  handle->wcet_overruns = 0;
+  handle->wcet_worst_ns = 0;
+  rclc_executor_handle_statistics_reset(&handle->statistics);
+  handle->deferred = false;
   return RCL_RET_OK;
 }
 
+void
+rclc_executor_handle_statistics_reset(rclc_executor_handle_statistics_t * statistics)
+{
+  memset(statistics, 0, sizeof(rclc_executor_handle_statistics_t));
+  statistics->callback_time_min_ns = UINT64_MAX;
+}
+
+void
+rclc_executor_handle_statistics_record(
+  rclc_executor_handle_statistics_t * statistics,
+  uint64_t duration_ns)
+{
+  statistics->invocations++;
+  statistics->callback_time_total_ns += duration_ns;
+  if (duration_ns < statistics->callback_time_min_ns) {
+    statistics->callback_time_min_ns = duration_ns;
+  }
+  if (duration_ns > statistics->callback_time_max_ns) {
+    statistics->callback_time_max_ns = duration_ns;
+  }
+  // bucket: floor(log2(duration_ns))
+  size_t bucket = 0;
+#if defined(__GNUC__) || defined(__clang__)
+  if (duration_ns > 1) {
+    bucket = 63 - (size_t) __builtin_clzll(duration_ns);
+  }
+#else
+  while ((duration_ns >>= 1) > 0) {
+    bucket++;
+  }
+#endif
+  if (bucket >= RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE) {
+    bucket = RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE - 1;
+  }
+  statistics->callback_time_histogram[bucket]++;
+}
+
 rcl_ret_t
 rclc_executor_handle_clear(
   rclc_executor_handle_t * handle,
@@ -89,6 +145,10 @@ rclc_executor_handle_print(rclc_executor_handle_t * handle)
       break;
     case RCLC_SUBSCRIPTION:
     case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_BATCH:
+    case RCLC_SUBSCRIPTION_LOANED:
+    case RCLC_SUBSCRIPTION_SERIALIZED:
+    case RCLC_SUBSCRIPTION_RING:
       typeName = "Sub";
       break;
     case RCLC_TIMER:
@@ -130,6 +190,10 @@ rclc_executor_handle_get_ptr(rclc_executor_handle_t * handle)
   switch (handle->type) {
     case RCLC_SUBSCRIPTION:
     case RCLC_SUBSCRIPTION_WITH_CONTEXT:
+    case RCLC_SUBSCRIPTION_BATCH:
+    case RCLC_SUBSCRIPTION_LOANED:
+    case RCLC_SUBSCRIPTION_SERIALIZED:
+    case RCLC_SUBSCRIPTION_RING:
       ptr = handle->subscription;
       break;
     case RCLC_TIMER:
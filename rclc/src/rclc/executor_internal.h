@@ -0,0 +1,40 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_INTERNAL_H_
+#define RCLC__EXECUTOR_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rclc/executor.h>
+#include <rclc/executor_handle.h>
+
+/**
+ *  Returns the handle of the executor with the rcl-handle \p rcl_handle (e.g. a
+ *  rcl_subscription_t) or NULL, if it has not been added. O(1). The pointer is only valid
+ *  until a handle is removed from the executor.
+ */
+rclc_executor_handle_t *
+rclc_executor_find_handle(
+  rclc_executor_t * executor,
+  const void * rcl_handle);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_INTERNAL_H_
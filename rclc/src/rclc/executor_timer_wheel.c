@@ -0,0 +1,358 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "./executor_timer_wheel_internal.h"
+
+#include <rcl/error_handling.h>
+
+#include "rclc/types.h"
+
+#define RCLC_TIMER_WHEEL_SLOT_MASK ((uint64_t) RCLC_TIMER_WHEEL_SLOTS - 1)
+/// number of ticks covered by all levels
+#define RCLC_TIMER_WHEEL_RANGE \
+  ((uint64_t) 1 << (RCLC_TIMER_WHEEL_SLOT_BITS * RCLC_TIMER_WHEEL_LEVELS))
+
+rcl_ret_t
+rclc_wheel_timer_init(
+  rclc_wheel_timer_t * timer,
+  uint64_t period_ns,
+  bool periodic,
+  rclc_wheel_timer_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  if (period_ns == 0) {
+    RCL_SET_ERROR_MSG("period of wheel timer must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  timer->period_ns = period_ns;
+  timer->periodic = periodic;
+  timer->callback = callback;
+  timer->context = context;
+  timer->active = false;
+  timer->period_ticks = 0;
+  timer->expiry_tick = 0;
+  timer->slot = NULL;
+  timer->next = NULL;
+  timer->prev = NULL;
+  return RCL_RET_OK;
+}
+
+/***
+ * stores the timer in the slot, which covers its expiry tick relative to the next tick
+ */
+static
+void
+_rclc_executor_timer_wheel_insert(
+  rclc_executor_timer_wheel_t * wheel,
+  rclc_wheel_timer_t * timer)
+{
+  if (timer->expiry_tick < wheel->tick) {
+    timer->expiry_tick = wheel->tick;
+  }
+  uint64_t expiry = timer->expiry_tick;
+  uint64_t remaining = expiry - wheel->tick;
+  if (remaining >= RCLC_TIMER_WHEEL_RANGE) {
+    // beyond the range of the wheel: stored in the last slot of the wheel and
+    // re-inserted, when this slot is cascaded
+    expiry = wheel->tick + RCLC_TIMER_WHEEL_RANGE - 1;
+    remaining = RCLC_TIMER_WHEEL_RANGE - 1;
+  }
+  size_t level = 0;
+  while (remaining >= ((uint64_t) 1 << (RCLC_TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+    level++;
+  }
+  size_t index = (size_t) ((expiry >> (RCLC_TIMER_WHEEL_SLOT_BITS * level)) &
+    RCLC_TIMER_WHEEL_SLOT_MASK);
+
+  rclc_wheel_timer_t ** slot = &wheel->slots[level][index];
+  timer->slot = slot;
+  timer->prev = NULL;
+  timer->next = *slot;
+  if (NULL != *slot) {
+    (*slot)->prev = timer;
+  }
+  *slot = timer;
+}
+
+/***
+ * removes the timer from its slot list
+ */
+static
+void
+_rclc_executor_timer_wheel_unlink(rclc_wheel_timer_t * timer)
+{
+  if (NULL != timer->prev) {
+    timer->prev->next = timer->next;
+  } else {
+    *timer->slot = timer->next;
+  }
+  if (NULL != timer->next) {
+    timer->next->prev = timer->prev;
+  }
+  timer->slot = NULL;
+  timer->next = NULL;
+  timer->prev = NULL;
+}
+
+/***
+ * moves all timers of a slot of a higher level to the lower levels
+ */
+static
+void
+_rclc_executor_timer_wheel_cascade(
+  rclc_executor_timer_wheel_t * wheel,
+  size_t level,
+  size_t index)
+{
+  rclc_wheel_timer_t * timer = wheel->slots[level][index];
+  wheel->slots[level][index] = NULL;
+  while (NULL != timer) {
+    rclc_wheel_timer_t * next = timer->next;
+    _rclc_executor_timer_wheel_insert(wheel, timer);
+    timer = next;
+  }
+}
+
+/***
+ * returns the tick of the current time of the clock
+ */
+static
+rcl_ret_t
+_rclc_executor_timer_wheel_now(
+  const rclc_executor_timer_wheel_t * wheel,
+  uint64_t * tick)
+{
+  rcl_time_point_value_t now = 0;
+  rcl_ret_t rc = rcl_clock_get_now(wheel->clock, &now);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel, rcl_clock_get_now);
+    return rc;
+  }
+  *tick = (now > wheel->start_time) ? (uint64_t) ((now - wheel->start_time) / wheel->tick_ns) : 0;
+  return RCL_RET_OK;
+}
+
+/***
+ * cancels the rcl timer of the wheel, if no wheel timer is started. During the processing
+ * of the expired timers this is done at the end of rclc_executor_timer_wheel_advance,
+ * because a callback may start another timer.
+ */
+static
+void
+_rclc_executor_timer_wheel_stop_if_idle(rclc_executor_timer_wheel_t * wheel)
+{
+  if ((wheel->active_timers > 0) || wheel->advancing) {
+    return;
+  }
+  rcl_ret_t rc = rcl_timer_cancel(&wheel->timer);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel, rcl_timer_cancel);
+  }
+}
+
+/***
+ * callback of the rcl timer of the wheel, which is called by the executor every tick
+ */
+static
+void
+_rclc_executor_timer_wheel_callback(rcl_timer_t * timer, int64_t last_call_time)
+{
+  RCLC_UNUSED(last_call_time);
+  // the rcl timer is the first member of the timer wheel
+  rclc_executor_timer_wheel_t * wheel = (rclc_executor_timer_wheel_t *) timer;
+  uint64_t tick = 0;
+  if (_rclc_executor_timer_wheel_now(wheel, &tick) == RCL_RET_OK) {
+    rclc_executor_timer_wheel_advance(wheel, tick);
+  }
+}
+
+rcl_ret_t
+rclc_executor_timer_wheel_init(
+  rclc_executor_timer_wheel_t ** wheel,
+  rcl_context_t * context,
+  rcl_clock_t * clock,
+  int64_t tick_ns,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if (tick_ns <= 0) {
+    RCL_SET_ERROR_MSG("tick of timer wheel must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_timer_wheel_t * w = allocator->zero_allocate(
+    1, sizeof(rclc_executor_timer_wheel_t), allocator->state);
+  if (NULL == w) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for timer wheel.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  w->clock = clock;
+  w->allocator = allocator;
+  w->tick_ns = tick_ns;
+  rcl_ret_t rc = rcl_clock_get_now(clock, &w->start_time);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel_init, rcl_clock_get_now);
+    allocator->deallocate(w, allocator->state);
+    return rc;
+  }
+  w->timer = rcl_get_zero_initialized_timer();
+  rc = rcl_timer_init2(
+    &w->timer, clock, context, tick_ns, _rclc_executor_timer_wheel_callback,
+    *allocator, true);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel_init, rcl_timer_init2);
+    allocator->deallocate(w, allocator->state);
+    return rc;
+  }
+  // no wheel timer is started yet
+  rc = rcl_timer_cancel(&w->timer);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel_init, rcl_timer_cancel);
+    (void) rcl_timer_fini(&w->timer);
+    allocator->deallocate(w, allocator->state);
+    return rc;
+  }
+  *wheel = w;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_timer_wheel_fini(rclc_executor_timer_wheel_t * wheel)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wheel, RCL_RET_INVALID_ARGUMENT);
+  for (size_t level = 0; level < RCLC_TIMER_WHEEL_LEVELS; level++) {
+    for (size_t index = 0; index < RCLC_TIMER_WHEEL_SLOTS; index++) {
+      while (NULL != wheel->slots[level][index]) {
+        rclc_wheel_timer_t * timer = wheel->slots[level][index];
+        _rclc_executor_timer_wheel_unlink(timer);
+        timer->active = false;
+      }
+    }
+  }
+  rcl_ret_t rc = rcl_timer_fini(&wheel->timer);
+  if (rc != RCL_RET_OK) {
+    PRINT_RCLC_ERROR(rclc_executor_timer_wheel_fini, rcl_timer_fini);
+  }
+  wheel->allocator->deallocate(wheel, wheel->allocator->state);
+  return rc;
+}
+
+rcl_ret_t
+rclc_executor_timer_wheel_start(
+  rclc_executor_timer_wheel_t * wheel,
+  rclc_wheel_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  uint64_t now_tick = 0;
+  rcl_ret_t rc = _rclc_executor_timer_wheel_now(wheel, &now_tick);
+  if (rc != RCL_RET_OK) {
+    return rc;
+  }
+  rclc_executor_timer_wheel_cancel(wheel, timer);
+  if ((wheel->active_timers == 0) && !wheel->advancing) {
+    // the rcl timer of the idle wheel is canceled and the ticks since then were not
+    // processed: re-arm the rcl timer and continue with the next tick
+    rc = rcl_timer_reset(&wheel->timer);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_timer_wheel_start, rcl_timer_reset);
+      return rc;
+    }
+    if (wheel->tick <= now_tick) {
+      wheel->tick = now_tick + 1;
+    }
+  }
+
+  // round the period up to full ticks
+  timer->period_ticks = (timer->period_ns + (uint64_t) wheel->tick_ns - 1) /
+    (uint64_t) wheel->tick_ns;
+  timer->expiry_tick = now_tick + timer->period_ticks;
+  _rclc_executor_timer_wheel_insert(wheel, timer);
+  timer->active = true;
+  wheel->active_timers++;
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_timer_wheel_cancel(
+  rclc_executor_timer_wheel_t * wheel,
+  rclc_wheel_timer_t * timer)
+{
+  if (timer->active) {
+    _rclc_executor_timer_wheel_unlink(timer);
+    timer->active = false;
+    wheel->active_timers--;
+    _rclc_executor_timer_wheel_stop_if_idle(wheel);
+  }
+}
+
+void
+rclc_executor_timer_wheel_advance(
+  rclc_executor_timer_wheel_t * wheel,
+  uint64_t target_tick)
+{
+  if (wheel->active_timers == 0) {
+    // nothing to expire or to cascade: skip the idle ticks
+    if (target_tick >= wheel->tick) {
+      wheel->tick = target_tick + 1;
+    }
+    _rclc_executor_timer_wheel_stop_if_idle(wheel);
+    return;
+  }
+  wheel->target_tick = target_tick;
+  wheel->advancing = true;
+  while (wheel->tick <= target_tick) {
+    uint64_t tick = wheel->tick;
+    // when a level wraps around, the current slot of the next level is due
+    for (size_t level = 1; level < RCLC_TIMER_WHEEL_LEVELS; level++) {
+      if (((tick >> (RCLC_TIMER_WHEEL_SLOT_BITS * (level - 1))) &
+        RCLC_TIMER_WHEEL_SLOT_MASK) != 0)
+      {
+        break;
+      }
+      _rclc_executor_timer_wheel_cascade(
+        wheel, level,
+        (size_t) ((tick >> (RCLC_TIMER_WHEEL_SLOT_BITS * level)) & RCLC_TIMER_WHEEL_SLOT_MASK));
+    }
+
+    // timers are removed one by one, because a callback may start or cancel other timers
+    rclc_wheel_timer_t ** slot = &wheel->slots[0][tick & RCLC_TIMER_WHEEL_SLOT_MASK];
+    while (NULL != *slot) {
+      rclc_wheel_timer_t * timer = *slot;
+      _rclc_executor_timer_wheel_unlink(timer);
+      if (timer->periodic) {
+        // drift-free: the next period starts at the expiry tick. Periods, which were missed
+        // because the executor has not been called, are skipped.
+        uint64_t expiry = timer->expiry_tick + timer->period_ticks;
+        if (expiry <= target_tick) {
+          expiry += ((target_tick - expiry) / timer->period_ticks + 1) * timer->period_ticks;
+        }
+        timer->expiry_tick = expiry;
+        _rclc_executor_timer_wheel_insert(wheel, timer);
+      } else {
+        timer->active = false;
+        wheel->active_timers--;
+      }
+      timer->callback(timer, timer->context);
+    }
+    wheel->tick++;
+  }
+  wheel->advancing = false;
+  _rclc_executor_timer_wheel_stop_if_idle(wheel);
+}
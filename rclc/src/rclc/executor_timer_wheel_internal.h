@@ -0,0 +1,107 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_TIMER_WHEEL_INTERNAL_H_
+#define RCLC__EXECUTOR_TIMER_WHEEL_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include <rclc/timer_wheel.h>
+
+/// number of bits of the slot index of one level of the timer wheel
+#define RCLC_TIMER_WHEEL_SLOT_BITS 6
+/// number of slots of one level
+#define RCLC_TIMER_WHEEL_SLOTS (1 << RCLC_TIMER_WHEEL_SLOT_BITS)
+/// number of levels, i.e. timeouts up to 2^24 ticks are stored without re-cascading
+#define RCLC_TIMER_WHEEL_LEVELS 4
+
+/**
+ *  Hashed hierarchical timer wheel. Level l has RCLC_TIMER_WHEEL_SLOTS slots of
+ *  2^(l * RCLC_TIMER_WHEEL_SLOT_BITS) ticks each. A timer is stored in the level, which covers
+ *  its remaining ticks, and moved down (cascaded) when the lower level wraps around. Therefore
+ *  starting and canceling a timer is O(1). The wheel is advanced by the callback of one rcl
+ *  timer, whose period is the tick. This rcl timer is canceled, while no wheel timer is
+ *  started, so that an idle wheel does not wake up the executor every tick.
+ */
+typedef struct rclc_executor_timer_wheel_s
+{
+  /// rcl timer, which drives the wheel (added to the executor as timer handle)
+  rcl_timer_t timer;
+  /// clock of the rcl timer
+  rcl_clock_t * clock;
+  const rcl_allocator_t * allocator;
+  /// duration of one tick in nanoseconds
+  int64_t tick_ns;
+  /// time of tick 0
+  rcl_time_point_value_t start_time;
+  /// next tick to be processed
+  uint64_t tick;
+  /// last tick to be processed by the current advance
+  uint64_t target_tick;
+  /// true, while the expired timers are processed by rclc_executor_timer_wheel_advance
+  bool advancing;
+  /// number of started timers
+  size_t active_timers;
+  /// slot lists of all levels
+  rclc_wheel_timer_t * slots[RCLC_TIMER_WHEEL_LEVELS][RCLC_TIMER_WHEEL_SLOTS];
+} rclc_executor_timer_wheel_t;
+
+/**
+ *  Creates a timer wheel with the resolution \p tick_ns and initializes its rcl timer with
+ *  \p clock and \p context.
+ */
+rcl_ret_t
+rclc_executor_timer_wheel_init(
+  rclc_executor_timer_wheel_t ** wheel,
+  rcl_context_t * context,
+  rcl_clock_t * clock,
+  int64_t tick_ns,
+  const rcl_allocator_t * allocator);
+
+/// Stops all timers, finalizes the rcl timer and frees the timer wheel.
+rcl_ret_t
+rclc_executor_timer_wheel_fini(rclc_executor_timer_wheel_t * wheel);
+
+/// Starts (or restarts) \p timer, it expires after its period. O(1).
+rcl_ret_t
+rclc_executor_timer_wheel_start(
+  rclc_executor_timer_wheel_t * wheel,
+  rclc_wheel_timer_t * timer);
+
+/// Stops \p timer, if it is started. O(1).
+void
+rclc_executor_timer_wheel_cancel(
+  rclc_executor_timer_wheel_t * wheel,
+  rclc_wheel_timer_t * timer);
+
+/**
+ *  Processes all ticks up to and including \p target_tick and calls the callbacks of the
+ *  expired timers. Periodic timers, which missed periods, are called once and continue
+ *  with the next period after \p target_tick.
+ */
+void
+rclc_executor_timer_wheel_advance(
+  rclc_executor_timer_wheel_t * wheel,
+  uint64_t target_tick);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_TIMER_WHEEL_INTERNAL_H_
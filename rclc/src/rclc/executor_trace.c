@@ -0,0 +1,218 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "./executor_trace_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rcl/error_handling.h>
+#include <rcutils/time.h>
+
+#include "rclc/types.h"
+
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+#endif
+
+#ifdef RCLC_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// largest capacity, which fits into the file header
+#define RCLC_EXECUTOR_TRACE_MAX_CAPACITY ((size_t) 1 << 31)
+
+struct rclc_executor_trace_s
+{
+  const rcl_allocator_t * allocator;
+  rclc_executor_trace_event_t * events;
+  size_t mask;
+  /// total number of recorded events, the next event is written at head & mask
+#ifndef __STDC_NO_ATOMICS__
+  atomic_uint_fast64_t head;
+#else
+  // without atomics only one thread may record events
+  uint64_t head;
+#endif
+};
+
+rcl_ret_t
+rclc_executor_trace_init(
+  rclc_executor_trace_t ** trace,
+  size_t capacity,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(trace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if ((capacity == 0) || (capacity > RCLC_EXECUTOR_TRACE_MAX_CAPACITY)) {
+    RCL_SET_ERROR_MSG("capacity must be greater than zero and at most 2^31");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // power of two, so that the position in the ring is computed with a mask
+  size_t size = 1;
+  while (size < capacity) {
+    size *= 2;
+  }
+
+  rclc_executor_trace_t * t = allocator->zero_allocate(
+    1, sizeof(rclc_executor_trace_t), allocator->state);
+  if (NULL == t) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for trace.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  t->events = allocator->zero_allocate(
+    size, sizeof(rclc_executor_trace_event_t), allocator->state);
+  if (NULL == t->events) {
+    allocator->deallocate(t, allocator->state);
+    RCL_SET_ERROR_MSG("Could not allocate memory for trace events.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  t->allocator = allocator;
+  t->mask = size - 1;
+#ifndef __STDC_NO_ATOMICS__
+  atomic_init(&t->head, 0);
+#else
+  t->head = 0;
+#endif
+  *trace = t;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_trace_fini(rclc_executor_trace_t * trace)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(trace, RCL_RET_INVALID_ARGUMENT);
+  const rcl_allocator_t * allocator = trace->allocator;
+  allocator->deallocate(trace->events, allocator->state);
+  allocator->deallocate(trace, allocator->state);
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_trace_record(
+  rclc_executor_trace_t * trace,
+  rclc_executor_trace_event_type_t type,
+  uint32_t handle_id,
+  int64_t value)
+{
+  rcutils_time_point_value_t now = 0;
+  RCLC_UNUSED(rcutils_steady_time_now(&now));
+#ifndef __STDC_NO_ATOMICS__
+  uint64_t pos = atomic_fetch_add_explicit(&trace->head, 1, memory_order_relaxed);
+#else
+  uint64_t pos = trace->head++;
+#endif
+  rclc_executor_trace_event_t * event = &trace->events[pos & trace->mask];
+  event->timestamp_ns = now;
+  event->type = (uint32_t) type;
+  event->handle_id = handle_id;
+  event->value = value;
+}
+
+/***
+ * copies the header and the events of the ring, oldest event first, to \p buffer
+ */
+static
+void
+_rclc_executor_trace_copy(
+  const rclc_executor_trace_t * trace,
+  const rclc_executor_trace_file_header_t * header,
+  uint64_t first,
+  uint8_t * buffer)
+{
+  memcpy(buffer, header, sizeof(rclc_executor_trace_file_header_t));
+  rclc_executor_trace_event_t * events =
+    (rclc_executor_trace_event_t *) (buffer + sizeof(rclc_executor_trace_file_header_t));
+  for (uint64_t i = 0; i < header->event_count; i++) {
+    events[i] = trace->events[(first + i) & trace->mask];
+  }
+}
+
+rcl_ret_t
+rclc_executor_trace_dump(
+  rclc_executor_trace_t * trace,
+  const char * path)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(trace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(path, RCL_RET_INVALID_ARGUMENT);
+
+#ifndef __STDC_NO_ATOMICS__
+  uint64_t head = atomic_load_explicit(&trace->head, memory_order_acquire);
+#else
+  uint64_t head = trace->head;
+#endif
+  uint64_t capacity = (uint64_t) trace->mask + 1;
+  rclc_executor_trace_file_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, RCLC_EXECUTOR_TRACE_MAGIC, sizeof(header.magic));
+  header.event_size = (uint32_t) sizeof(rclc_executor_trace_event_t);
+  header.capacity = (uint32_t) capacity;
+  header.event_count = (head < capacity) ? head : capacity;
+  header.dropped_count = head - header.event_count;
+  uint64_t first = head - header.event_count;
+  size_t file_size = sizeof(header) +
+    (size_t) header.event_count * sizeof(rclc_executor_trace_event_t);
+
+#ifdef RCLC_USE_MMAP
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    RCL_SET_ERROR_MSG("Could not open trace file.");
+    return RCL_RET_ERROR;
+  }
+  if (ftruncate(fd, (off_t) file_size) != 0) {
+    close(fd);
+    RCL_SET_ERROR_MSG("Could not resize trace file.");
+    return RCL_RET_ERROR;
+  }
+  void * buffer = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (buffer == MAP_FAILED) {
+    close(fd);
+    RCL_SET_ERROR_MSG("Could not map trace file.");
+    return RCL_RET_ERROR;
+  }
+  _rclc_executor_trace_copy(trace, &header, first, (uint8_t *) buffer);
+  int rc_sync = msync(buffer, file_size, MS_SYNC);
+  munmap(buffer, file_size);
+  close(fd);
+  if (rc_sync != 0) {
+    RCL_SET_ERROR_MSG("Could not write trace file.");
+    return RCL_RET_ERROR;
+  }
+#else
+  // no memory mapping available: copy into a temporary buffer and write the file
+  uint8_t * buffer = trace->allocator->allocate(file_size, trace->allocator->state);
+  if (NULL == buffer) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for trace file.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  _rclc_executor_trace_copy(trace, &header, first, buffer);
+  FILE * file = fopen(path, "wb");
+  size_t written = 0;
+  if (NULL != file) {
+    written = fwrite(buffer, 1, file_size, file);
+    if (fclose(file) != 0) {
+      written = 0;
+    }
+  }
+  trace->allocator->deallocate(buffer, trace->allocator->state);
+  if (written != file_size) {
+    RCL_SET_ERROR_MSG("Could not write trace file.");
+    return RCL_RET_ERROR;
+  }
+#endif
+  return RCL_RET_OK;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_TRACE_INTERNAL_H_
+#define RCLC__EXECUTOR_TRACE_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include <rclc/executor_trace.h>
+
+/// Preallocated ring of trace events. The struct is opaque, because it uses C11 atomics.
+typedef struct rclc_executor_trace_s rclc_executor_trace_t;
+
+/**
+ *  Creates a trace ring for at least \p capacity events. The capacity is rounded up to a
+ *  power of two.
+ */
+rcl_ret_t
+rclc_executor_trace_init(
+  rclc_executor_trace_t ** trace,
+  size_t capacity,
+  const rcl_allocator_t * allocator);
+
+/// Frees the trace ring. No event may be recorded concurrently.
+rcl_ret_t
+rclc_executor_trace_fini(rclc_executor_trace_t * trace);
+
+/**
+ *  Records an event. The slot is reserved with an atomic increment, so events can be recorded
+ *  concurrently by the executor and its worker threads without locks. If the ring is full,
+ *  the oldest event is overwritten. Does not allocate memory.
+ */
+void
+rclc_executor_trace_record(
+  rclc_executor_trace_t * trace,
+  rclc_executor_trace_event_type_t type,
+  uint32_t handle_id,
+  int64_t value);
+
+/**
+ *  Writes the events of the ring, oldest event first, after a rclc_executor_trace_file_header_t
+ *  to the file \p path. On POSIX systems the file is written through a memory mapping.
+ *  Events, which are recorded concurrently, may be incomplete in the file.
+ */
+rcl_ret_t
+rclc_executor_trace_dump(
+  rclc_executor_trace_t * trace,
+  const char * path);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_TRACE_INTERNAL_H_
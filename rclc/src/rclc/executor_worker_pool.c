@@ -0,0 +1,448 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./executor_worker_pool_internal.h"
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+
+#include "rclc/types.h"
+
+#if defined(RCLC_USE_PTHREAD) && !defined(__STDC_NO_ATOMICS__)
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/// Bounded double-ended queue of dispatched handles. Handles are pushed and popped at the
+/// bottom by the owner and stolen at the top by other worker threads.
+typedef struct
+{
+  pthread_mutex_t mutex;
+  rclc_executor_handle_t ** buffer;
+  size_t size;
+  size_t top;
+  size_t count;
+} rclc_executor_worker_deque_t;
+
+typedef struct
+{
+  pthread_t thread;
+  rclc_executor_worker_pool_t * pool;
+  /// index of the deque of this worker
+  size_t deque_index;
+} rclc_executor_worker_t;
+
+struct rclc_executor_worker_pool_s
+{
+  /// protects shutdown. It is only taken to put idle workers to sleep, to wake them up and to
+  /// wait until the pool is idle, finishing a callback does not take it.
+  pthread_mutex_t mutex;
+  /// signaled, if a handle was dispatched or the pool shuts down
+  pthread_cond_t work_available;
+  /// signaled, if no handle is queued or executed
+  pthread_cond_t idle;
+  rclc_executor_worker_t * workers;
+  size_t number_of_threads;
+  /// one deque per worker (work stealing) or one deque shared by all workers (global queue)
+  rclc_executor_worker_deque_t * deques;
+  size_t number_of_deques;
+  /// deque, to which the next handle is dispatched
+  size_t next_deque;
+  bool work_stealing;
+  /// handles of the executor, busy[i] is the busy flag of handles[i]
+  rclc_executor_handle_t * handles;
+  size_t number_of_handles;
+  /// one flag per handle, which is true while the handle is queued or executed
+  atomic_bool * busy;
+  /// number of handles, which are queued or executed
+  atomic_size_t outstanding;
+  /// number of workers, which wait or are about to wait for work_available
+  atomic_size_t sleeping;
+  bool shutdown;
+  /// first error returned by a callback execution
+  _Atomic rcl_ret_t error;
+  rclc_executor_worker_pool_execute_t execute;
+  /// monitoring configuration of the executor, which is passed to execute
+  const rclc_executor_monitoring_t * monitoring;
+  rcl_guard_condition_t * guard_condition;
+  const rcl_allocator_t * allocator;
+};
+
+static
+void
+_rclc_executor_worker_deque_push_bottom(
+  rclc_executor_worker_deque_t * deque,
+  rclc_executor_handle_t * handle)
+{
+  pthread_mutex_lock(&deque->mutex);
+  deque->buffer[(deque->top + deque->count) % deque->size] = handle;
+  deque->count++;
+  pthread_mutex_unlock(&deque->mutex);
+}
+
+static
+rclc_executor_handle_t *
+_rclc_executor_worker_deque_pop_bottom(rclc_executor_worker_deque_t * deque)
+{
+  rclc_executor_handle_t * handle = NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    deque->count--;
+    handle = deque->buffer[(deque->top + deque->count) % deque->size];
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return handle;
+}
+
+static
+rclc_executor_handle_t *
+_rclc_executor_worker_deque_pop_top(rclc_executor_worker_deque_t * deque)
+{
+  rclc_executor_handle_t * handle = NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    handle = deque->buffer[deque->top];
+    deque->top = (deque->top + 1) % deque->size;
+    deque->count--;
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return handle;
+}
+
+/// Takes the next handle from the own deque or steals one from the deques of other workers.
+static
+rclc_executor_handle_t *
+_rclc_executor_worker_next_handle(rclc_executor_worker_t * worker)
+{
+  rclc_executor_worker_pool_t * pool = worker->pool;
+  rclc_executor_handle_t * handle;
+
+  if (!pool->work_stealing) {
+    // global queue: first-in first-out
+    return _rclc_executor_worker_deque_pop_top(&pool->deques[0]);
+  }
+  handle = _rclc_executor_worker_deque_pop_bottom(&pool->deques[worker->deque_index]);
+  for (size_t i = 1; (NULL == handle) && (i < pool->number_of_deques); i++) {
+    size_t victim = (worker->deque_index + i) % pool->number_of_deques;
+    handle = _rclc_executor_worker_deque_pop_top(&pool->deques[victim]);
+  }
+  return handle;
+}
+
+static
+void *
+_rclc_executor_worker_pool_thread(void * arg)
+{
+  rclc_executor_worker_t * worker = (rclc_executor_worker_t *) arg;
+  rclc_executor_worker_pool_t * pool = worker->pool;
+
+  while (true) {
+    // fast path: only the locks of the deques are taken
+    rclc_executor_handle_t * handle = _rclc_executor_worker_next_handle(worker);
+    if (NULL == handle) {
+      // the worker announces that it sleeps, before it looks into the deques again. A handle,
+      // which is dispatched in between, is either found or the dispatcher sees the sleeping
+      // worker and signals work_available (see rclc_executor_worker_pool_dispatch).
+      pthread_mutex_lock(&pool->mutex);
+      atomic_fetch_add(&pool->sleeping, 1);
+      atomic_thread_fence(memory_order_seq_cst);
+      handle = _rclc_executor_worker_next_handle(worker);
+      while ((NULL == handle) && !pool->shutdown) {
+        pthread_cond_wait(&pool->work_available, &pool->mutex);
+        handle = _rclc_executor_worker_next_handle(worker);
+      }
+      atomic_fetch_sub(&pool->sleeping, 1);
+      pthread_mutex_unlock(&pool->mutex);
+      if (NULL == handle) {
+        // shutdown and all dispatched handles have been executed
+        break;
+      }
+    }
+
+    rcl_ret_t rc = pool->execute(handle, pool->monitoring);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_worker_pool, execute);
+      rcl_ret_t no_error = RCL_RET_OK;
+      atomic_compare_exchange_strong(&pool->error, &no_error, rc);
+    }
+
+    // the handle can be dispatched again, the release publishes the results of the callback
+    atomic_store_explicit(
+      &pool->busy[handle - pool->handles], false, memory_order_release);
+    if (atomic_fetch_sub(&pool->outstanding, 1) == 1) {
+      pthread_mutex_lock(&pool->mutex);
+      pthread_cond_broadcast(&pool->idle);
+      pthread_mutex_unlock(&pool->mutex);
+    }
+    // wake up rcl_wait, so that the handle is added to the wait_set again
+    rc = rcl_trigger_guard_condition(pool->guard_condition);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_executor_worker_pool, rcl_trigger_guard_condition);
+    }
+  }
+  return NULL;
+}
+
+static
+void
+_rclc_executor_worker_pool_free(rclc_executor_worker_pool_t * pool)
+{
+  const rcl_allocator_t * allocator = pool->allocator;
+  for (size_t i = 0; i < pool->number_of_deques; i++) {
+    pthread_mutex_destroy(&pool->deques[i].mutex);
+    allocator->deallocate(pool->deques[i].buffer, allocator->state);
+  }
+  pthread_cond_destroy(&pool->idle);
+  pthread_cond_destroy(&pool->work_available);
+  pthread_mutex_destroy(&pool->mutex);
+  allocator->deallocate(pool->busy, allocator->state);
+  allocator->deallocate(pool->deques, allocator->state);
+  allocator->deallocate(pool->workers, allocator->state);
+  allocator->deallocate(pool, allocator->state);
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_init(
+  rclc_executor_worker_pool_t ** pool,
+  size_t number_of_threads,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  rclc_executor_worker_scheduling_t scheduling,
+  rclc_executor_worker_pool_execute_t execute,
+  const rclc_executor_monitoring_t * monitoring,
+  rcl_guard_condition_t * guard_condition,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handles, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(execute, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(monitoring, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if ((number_of_threads == 0) || (number_of_handles == 0)) {
+    RCL_SET_ERROR_MSG("number_of_threads and number_of_handles must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rclc_executor_worker_pool_t * p = allocator->zero_allocate(
+    1, sizeof(rclc_executor_worker_pool_t), allocator->state);
+  if (NULL == p) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for worker pool.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  p->allocator = allocator;
+  p->execute = execute;
+  p->monitoring = monitoring;
+  p->guard_condition = guard_condition;
+  p->handles = handles;
+  p->number_of_handles = number_of_handles;
+  atomic_init(&p->outstanding, 0);
+  atomic_init(&p->sleeping, 0);
+  atomic_init(&p->error, RCL_RET_OK);
+  p->work_stealing = (scheduling == RCLC_WORKER_SCHEDULING_WORK_STEALING);
+  size_t number_of_deques = p->work_stealing ? number_of_threads : 1;
+  p->workers = allocator->zero_allocate(
+    number_of_threads, sizeof(rclc_executor_worker_t), allocator->state);
+  p->deques = allocator->zero_allocate(
+    number_of_deques, sizeof(rclc_executor_worker_deque_t), allocator->state);
+  p->busy = allocator->allocate(number_of_handles * sizeof(atomic_bool), allocator->state);
+  if ((NULL == p->workers) || (NULL == p->deques) || (NULL == p->busy)) {
+    allocator->deallocate(p->busy, allocator->state);
+    allocator->deallocate(p->deques, allocator->state);
+    allocator->deallocate(p->workers, allocator->state);
+    allocator->deallocate(p, allocator->state);
+    RCL_SET_ERROR_MSG("Could not allocate memory for worker pool.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < number_of_handles; i++) {
+    atomic_init(&p->busy[i], false);
+  }
+  pthread_mutex_init(&p->mutex, NULL);
+  pthread_cond_init(&p->work_available, NULL);
+  pthread_cond_init(&p->idle, NULL);
+
+  // every handle is queued at most once, so each deque can hold all handles
+  for (; p->number_of_deques < number_of_deques; p->number_of_deques++) {
+    rclc_executor_worker_deque_t * deque = &p->deques[p->number_of_deques];
+    deque->buffer = allocator->allocate(
+      number_of_handles * sizeof(rclc_executor_handle_t *), allocator->state);
+    if (NULL == deque->buffer) {
+      _rclc_executor_worker_pool_free(p);
+      RCL_SET_ERROR_MSG("Could not allocate memory for worker pool.");
+      return RCL_RET_BAD_ALLOC;
+    }
+    deque->size = number_of_handles;
+    pthread_mutex_init(&deque->mutex, NULL);
+  }
+
+  for (; p->number_of_threads < number_of_threads; p->number_of_threads++) {
+    rclc_executor_worker_t * worker = &p->workers[p->number_of_threads];
+    worker->pool = p;
+    worker->deque_index = p->number_of_threads % number_of_deques;
+    if (0 != pthread_create(&worker->thread, NULL, _rclc_executor_worker_pool_thread, worker)) {
+      RCL_SET_ERROR_MSG("Could not create worker thread.");
+      rclc_executor_worker_pool_fini(p);
+      return RCL_RET_ERROR;
+    }
+  }
+  *pool = p;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_fini(rclc_executor_worker_pool_t * pool)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->work_available);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for (size_t i = 0; i < pool->number_of_threads; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+  _rclc_executor_worker_pool_free(pool);
+  return RCL_RET_OK;
+}
+
+bool
+rclc_executor_worker_pool_is_busy(
+  rclc_executor_worker_pool_t * pool,
+  const rclc_executor_handle_t * handle)
+{
+  // the acquire makes the results of the last callback of the handle visible
+  return atomic_load_explicit(&pool->busy[handle - pool->handles], memory_order_acquire);
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_dispatch(
+  rclc_executor_worker_pool_t * pool,
+  rclc_executor_handle_t * handle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+
+  if ((handle < pool->handles) || (handle >= pool->handles + pool->number_of_handles)) {
+    RCL_SET_ERROR_MSG("handle does not belong to the executor of the worker pool");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  atomic_bool * busy = &pool->busy[handle - pool->handles];
+  if (atomic_load(busy) || (atomic_load(&pool->outstanding) == pool->number_of_handles)) {
+    RCL_SET_ERROR_MSG("handle is busy or dispatch queue is full");
+    return RCL_RET_ERROR;
+  }
+  atomic_store(busy, true);
+  atomic_fetch_add(&pool->outstanding, 1);
+  // distribute the handles round-robin to the deques of the workers
+  _rclc_executor_worker_deque_push_bottom(&pool->deques[pool->next_deque], handle);
+  pool->next_deque = (pool->next_deque + 1) % pool->number_of_deques;
+  // the pool is only locked, if a worker sleeps (see _rclc_executor_worker_pool_thread)
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load(&pool->sleeping) > 0) {
+    pthread_mutex_lock(&pool->mutex);
+    pthread_cond_signal(&pool->work_available);
+    pthread_mutex_unlock(&pool->mutex);
+  }
+  return RCL_RET_OK;
+}
+
+void
+rclc_executor_worker_pool_wait_idle(rclc_executor_worker_pool_t * pool)
+{
+  pthread_mutex_lock(&pool->mutex);
+  while (atomic_load(&pool->outstanding) > 0) {
+    pthread_cond_wait(&pool->idle, &pool->mutex);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_get_error(rclc_executor_worker_pool_t * pool)
+{
+  return atomic_exchange(&pool->error, RCL_RET_OK);
+}
+
+#else  // RCLC_USE_PTHREAD && !__STDC_NO_ATOMICS__
+
+// No threading library or no C11 atomics available: the executor can only be used
+// single-threaded.
+
+rcl_ret_t
+rclc_executor_worker_pool_init(
+  rclc_executor_worker_pool_t ** pool,
+  size_t number_of_threads,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  rclc_executor_worker_scheduling_t scheduling,
+  rclc_executor_worker_pool_execute_t execute,
+  const rclc_executor_monitoring_t * monitoring,
+  rcl_guard_condition_t * guard_condition,
+  const rcl_allocator_t * allocator)
+{
+  RCLC_UNUSED(pool);
+  RCLC_UNUSED(number_of_threads);
+  RCLC_UNUSED(handles);
+  RCLC_UNUSED(number_of_handles);
+  RCLC_UNUSED(scheduling);
+  RCLC_UNUSED(execute);
+  RCLC_UNUSED(monitoring);
+  RCLC_UNUSED(guard_condition);
+  RCLC_UNUSED(allocator);
+  RCL_SET_ERROR_MSG("multi-threaded executor requires POSIX threads and C11 atomics");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_fini(rclc_executor_worker_pool_t * pool)
+{
+  RCLC_UNUSED(pool);
+  return RCL_RET_UNSUPPORTED;
+}
+
+bool
+rclc_executor_worker_pool_is_busy(
+  rclc_executor_worker_pool_t * pool,
+  const rclc_executor_handle_t * handle)
+{
+  RCLC_UNUSED(pool);
+  RCLC_UNUSED(handle);
+  return false;
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_dispatch(
+  rclc_executor_worker_pool_t * pool,
+  rclc_executor_handle_t * handle)
+{
+  RCLC_UNUSED(pool);
+  RCLC_UNUSED(handle);
+  return RCL_RET_UNSUPPORTED;
+}
+
+void
+rclc_executor_worker_pool_wait_idle(rclc_executor_worker_pool_t * pool)
+{
+  RCLC_UNUSED(pool);
+}
+
+rcl_ret_t
+rclc_executor_worker_pool_get_error(rclc_executor_worker_pool_t * pool)
+{
+  RCLC_UNUSED(pool);
+  return RCL_RET_UNSUPPORTED;
+}
+
+#endif  // RCLC_USE_PTHREAD && !__STDC_NO_ATOMICS__
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef RCLC__EXECUTOR_WORKER_POOL_INTERNAL_H_
+#define RCLC__EXECUTOR_WORKER_POOL_INTERNAL_H_
+
+#if __cplusplus
+extern "C"
+{
+#endif
+
+#include <rcl/rcl.h>
+
+#include <rclc/executor.h>
+#include <rclc/executor_handle.h>
+
+/// Function, which is called by a worker thread to execute the callback of a handle with the
+/// monitoring configuration of the executor.
+typedef rcl_ret_t (* rclc_executor_worker_pool_execute_t)(
+  rclc_executor_handle_t *, const rclc_executor_monitoring_t *);
+
+/// Fixed-size pool of worker threads, which execute the callbacks of dispatched handles.
+/// The struct is opaque, because its implementation depends on the threading library.
+typedef struct rclc_executor_worker_pool_s rclc_executor_worker_pool_t;
+
+/**
+ *  Creates a pool with \p number_of_threads worker threads for the array \p handles of
+ *  \p number_of_handles handles of an executor, of which each can be dispatched once at a
+ *  time. The pool keeps the busy flags of the handles as atomics, so finishing a callback
+ *  does not take the lock of the pool. With RCLC_WORKER_SCHEDULING_WORK_STEALING every worker
+ *  has its own deque, to which handles are dispatched round-robin, and idle workers steal
+ *  from the deques of other workers. With RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE all workers
+ *  share one queue. The \p guard_condition is triggered every time a worker thread has
+ *  finished the execution of a handle. The \p monitoring configuration is passed to every
+ *  call of \p execute and must stay valid until the pool is finalized.
+ *
+ * \return `RCL_RET_UNSUPPORTED` if no threading library or no C11 atomics are available on
+ *   this platform
+ */
+rcl_ret_t
+rclc_executor_worker_pool_init(
+  rclc_executor_worker_pool_t ** pool,
+  size_t number_of_threads,
+  rclc_executor_handle_t * handles,
+  size_t number_of_handles,
+  rclc_executor_worker_scheduling_t scheduling,
+  rclc_executor_worker_pool_execute_t execute,
+  const rclc_executor_monitoring_t * monitoring,
+  rcl_guard_condition_t * guard_condition,
+  const rcl_allocator_t * allocator);
+
+/// Waits until all dispatched handles are executed, joins the worker threads and frees the pool.
+rcl_ret_t
+rclc_executor_worker_pool_fini(rclc_executor_worker_pool_t * pool);
+
+/// Returns true, while \p handle is queued or executed by a worker thread. If it returns
+/// false, the results of the last callback of the handle are visible to the caller.
+bool
+rclc_executor_worker_pool_is_busy(
+  rclc_executor_worker_pool_t * pool,
+  const rclc_executor_handle_t * handle);
+
+/**
+ *  Marks \p handle as busy and queues it for execution by one of the worker threads.
+ *  Handles may only be dispatched by one thread.
+ *
+ * \return `RCL_RET_INVALID_ARGUMENT` if \p handle is not a handle of the pool
+ * \return `RCL_RET_ERROR` if the handle is already busy or the queue is full
+ */
+rcl_ret_t
+rclc_executor_worker_pool_dispatch(
+  rclc_executor_worker_pool_t * pool,
+  rclc_executor_handle_t * handle);
+
+/// Blocks until no handle is queued or executed. Must not be called by a worker thread.
+void
+rclc_executor_worker_pool_wait_idle(rclc_executor_worker_pool_t * pool);
+
+/// Returns the first error returned by a callback execution since the last call and resets it.
+rcl_ret_t
+rclc_executor_worker_pool_get_error(rclc_executor_worker_pool_t * pool);
+
+#if __cplusplus
+}
+#endif
+
+#endif  // RCLC__EXECUTOR_WORKER_POOL_INTERNAL_H_
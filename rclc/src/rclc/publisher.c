@@ -77,3 +77,120 @@ rclc_publisher_init(
   }
   return rc;
 }
+
+rcl_ret_t
+rclc_publisher_loan_init(
+  rclc_publisher_loan_t * loan,
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void * fallback_msg)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    loan, "loan is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    publisher, "publisher is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    type_support, "type_support is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    fallback_msg, "fallback_msg is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  loan->publisher = publisher;
+  loan->type_support = type_support;
+  loan->fallback_msg = fallback_msg;
+  loan->borrowed_msg = NULL;
+  loan->is_loaned = false;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_publisher_borrow_message(
+  rclc_publisher_loan_t * loan,
+  void ** msg)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    loan, "loan is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    msg, "msg is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != loan->borrowed_msg) {
+    RCL_SET_ERROR_MSG("a message is already borrowed");
+    return RCL_RET_ERROR;
+  }
+
+  if (rcl_publisher_can_loan_messages(loan->publisher)) {
+    void * loaned_msg = NULL;
+    rcl_ret_t rc = rcl_borrow_loaned_message(loan->publisher, loan->type_support, &loaned_msg);
+    if (rc == RCL_RET_OK) {
+      loan->borrowed_msg = loaned_msg;
+      loan->is_loaned = true;
+      *msg = loaned_msg;
+      return RCL_RET_OK;
+    }
+    // the middleware could not loan a message: fall back to the preallocated message
+    rcutils_reset_error();
+  }
+  loan->borrowed_msg = loan->fallback_msg;
+  loan->is_loaned = false;
+  *msg = loan->fallback_msg;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_publisher_publish_borrowed_message(rclc_publisher_loan_t * loan)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    loan, "loan is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL == loan->borrowed_msg) {
+    RCL_SET_ERROR_MSG("no message is borrowed");
+    return RCL_RET_ERROR;
+  }
+
+  rcl_ret_t rc;
+  if (loan->is_loaned) {
+    // the ownership of the loaned message is passed back to the middleware
+    rc = rcl_publish_loaned_message(loan->publisher, loan->borrowed_msg, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_publisher_publish_borrowed_message, rcl_publish_loaned_message);
+    }
+  } else {
+    rc = rcl_publish(loan->publisher, loan->borrowed_msg, NULL);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(rclc_publisher_publish_borrowed_message, rcl_publish);
+    }
+  }
+  loan->borrowed_msg = NULL;
+  loan->is_loaned = false;
+  return rc;
+}
+
+rcl_ret_t
+rclc_publisher_return_borrowed_message(rclc_publisher_loan_t * loan)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    loan, "loan is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = RCL_RET_OK;
+  if ((NULL != loan->borrowed_msg) && loan->is_loaned) {
+    rc = rcl_return_loaned_message_from_publisher(loan->publisher, loan->borrowed_msg);
+    if (rc != RCL_RET_OK) {
+      PRINT_RCLC_ERROR(
+        rclc_publisher_return_borrowed_message,
+        rcl_return_loaned_message_from_publisher);
+    }
+  }
+  loan->borrowed_msg = NULL;
+  loan->is_loaned = false;
+  return rc;
+}
+
+rcl_ret_t
+rclc_publisher_loan_fini(rclc_publisher_loan_t * loan)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    loan, "loan is a null pointer", return RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t rc = rclc_publisher_return_borrowed_message(loan);
+  loan->publisher = NULL;
+  loan->type_support = NULL;
+  loan->fallback_msg = NULL;
+  return rc;
+}
@@ -19,6 +19,8 @@
 #ifdef WIN32
 #include <Windows.h>
 #else
+#include <errno.h>
+#include <time.h>
 #include <unistd.h>
 #endif
 
@@ -32,3 +34,50 @@ rclc_sleep_ms(
   usleep(ms * 1000);
 #endif
 }
+
+int64_t
+rclc_monotonic_time_ns(void)
+{
+#ifdef WIN32
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  // split to avoid an overflow of counter * 10^9
+  return (int64_t) (counter.QuadPart / frequency.QuadPart) * 1000000000LL +
+         (int64_t) (counter.QuadPart % frequency.QuadPart) * 1000000000LL / frequency.QuadPart;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (int64_t) now.tv_sec * 1000000000LL + now.tv_nsec;
+#endif
+}
+
+void
+rclc_sleep_until_ns(
+  int64_t time_point_ns)
+{
+#if defined(__linux__)
+  struct timespec deadline;
+  deadline.tv_sec = (time_t) (time_point_ns / 1000000000LL);
+  deadline.tv_nsec = (long) (time_point_ns % 1000000000LL);
+  // an absolute deadline does not need to be recomputed after an interruption by a signal
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+  }
+#elif defined(WIN32)
+  int64_t sleep_time = time_point_ns - rclc_monotonic_time_ns();
+  if (sleep_time > 0) {
+    // round up, so that the time point has passed after the sleep
+    Sleep((DWORD) ((sleep_time + 999999) / 1000000));
+  }
+#else
+  int64_t sleep_time = time_point_ns - rclc_monotonic_time_ns();
+  if (sleep_time > 0) {
+    struct timespec duration;
+    duration.tv_sec = (time_t) (sleep_time / 1000000000LL);
+    duration.tv_nsec = (long) (sleep_time % 1000000000LL);
+    while (nanosleep(&duration, &duration) == -1 && errno == EINTR) {
+    }
+  }
+#endif
+}
@@ -0,0 +1,265 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "rclc/synchronizer.h"
+
+#include <rcl/error_handling.h>
+#include <rcutils/logging_macros.h>
+
+#include "rclc/executor.h"
+
+#include "./executor_internal.h"
+
+rclc_synchronizer_t
+rclc_synchronizer_get_zero_initialized_synchronizer(void)
+{
+  static rclc_synchronizer_t null_synchronizer = {
+    .depth = 0,
+    .slop_ns = 0,
+    .callback = NULL,
+    .context = NULL,
+    .inputs = NULL,
+    .size = 0,
+    .capacity = 0,
+    .tuple = NULL,
+    .tuple_stamps = NULL,
+    .matches = 0,
+    .executor = NULL,
+    .allocator = NULL,
+  };
+  return null_synchronizer;
+}
+
+rcl_ret_t
+rclc_synchronizer_init(
+  rclc_synchronizer_t * synchronizer,
+  size_t max_inputs,
+  size_t depth,
+  uint64_t slop_ns,
+  rclc_synchronizer_callback_t callback,
+  void * context,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(synchronizer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if ((max_inputs == 0) || (depth == 0)) {
+    RCL_SET_ERROR_MSG("max_inputs and depth must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  synchronizer->inputs = allocator->zero_allocate(
+    max_inputs, sizeof(rclc_synchronizer_input_t), allocator->state);
+  if (NULL == synchronizer->inputs) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for synchronizer inputs.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  synchronizer->tuple = allocator->zero_allocate(
+    max_inputs, sizeof(void *), allocator->state);
+  if (NULL == synchronizer->tuple) {
+    allocator->deallocate(synchronizer->inputs, allocator->state);
+    synchronizer->inputs = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for synchronizer tuple.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  synchronizer->tuple_stamps = allocator->zero_allocate(
+    max_inputs, sizeof(int64_t), allocator->state);
+  if (NULL == synchronizer->tuple_stamps) {
+    allocator->deallocate(synchronizer->tuple, allocator->state);
+    allocator->deallocate(synchronizer->inputs, allocator->state);
+    synchronizer->tuple = NULL;
+    synchronizer->inputs = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for synchronizer time stamps.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  synchronizer->depth = depth;
+  synchronizer->slop_ns = slop_ns;
+  synchronizer->callback = callback;
+  synchronizer->context = context;
+  synchronizer->size = 0;
+  synchronizer->capacity = max_inputs;
+  synchronizer->matches = 0;
+  synchronizer->executor = NULL;
+  synchronizer->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_synchronizer_fini(rclc_synchronizer_t * synchronizer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(synchronizer, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  // the executor must not call the ring callbacks with the freed inputs
+  for (size_t i = 0; i < synchronizer->size; i++) {
+    rcl_subscription_t * subscription = synchronizer->inputs[i].subscription;
+    if (NULL != rclc_executor_find_handle(synchronizer->executor, subscription)) {
+      rcl_ret_t rc = rclc_executor_remove_subscription(synchronizer->executor, subscription);
+      if (RCL_RET_OK != rc) {
+        ret = rc;
+      }
+    }
+  }
+  if (NULL != synchronizer->allocator) {
+    synchronizer->allocator->deallocate(synchronizer->inputs, synchronizer->allocator->state);
+    synchronizer->allocator->deallocate(synchronizer->tuple, synchronizer->allocator->state);
+    synchronizer->allocator->deallocate(
+      synchronizer->tuple_stamps, synchronizer->allocator->state);
+  }
+  *synchronizer = rclc_synchronizer_get_zero_initialized_synchronizer();
+  return ret;
+}
+
+/***
+ * returns the difference of two time stamps. It is computed unsigned, so that the
+ * difference of any two time stamps does not overflow.
+ */
+static
+uint64_t
+_rclc_synchronizer_stamp_diff(int64_t a, int64_t b)
+{
+  return (a > b) ? (uint64_t) a - (uint64_t) b : (uint64_t) b - (uint64_t) a;
+}
+
+/***
+ * builds the tuple around the message \p msg with the time stamp \p stamp of the input
+ * \p pivot. For every other input the unmatched message closest in time is selected from
+ * the ring of its handle, which is read directly from the executor: with LET-semantics all
+ * rings are filled before any ring callback is called. Returns true, if all inputs have a
+ * message and the time stamps of the tuple are within the slop.
+ */
+static
+bool
+_rclc_synchronizer_match(
+  rclc_synchronizer_t * synchronizer,
+  size_t pivot,
+  const void * msg,
+  int64_t stamp)
+{
+  int64_t oldest = stamp;
+  int64_t newest = stamp;
+  synchronizer->tuple[pivot] = msg;
+  synchronizer->tuple_stamps[pivot] = stamp;
+  for (size_t i = 0; i < synchronizer->size; i++) {
+    if (i == pivot) {
+      continue;
+    }
+    rclc_synchronizer_input_t * input = &synchronizer->inputs[i];
+    const rclc_executor_handle_t * handle =
+      rclc_executor_find_handle(synchronizer->executor, input->subscription);
+    if (NULL == handle) {
+      return false;
+    }
+    const void * best = NULL;
+    int64_t best_stamp = 0;
+    uint64_t best_diff = UINT64_MAX;
+    for (size_t j = 0; j < handle->data_ring_size; j++) {
+      const void * candidate = handle->data_ring_snapshot[j];
+      int64_t s = input->stamp(candidate);
+      if (s <= input->last_stamp) {
+        continue;
+      }
+      uint64_t diff = _rclc_synchronizer_stamp_diff(s, stamp);
+      if ((NULL == best) || (diff < best_diff)) {
+        best = candidate;
+        best_stamp = s;
+        best_diff = diff;
+      }
+    }
+    if ((NULL == best) || (best_diff > synchronizer->slop_ns)) {
+      return false;
+    }
+    synchronizer->tuple[i] = best;
+    synchronizer->tuple_stamps[i] = best_stamp;
+    if (best_stamp < oldest) {
+      oldest = best_stamp;
+    }
+    if (best_stamp > newest) {
+      newest = best_stamp;
+    }
+  }
+  return _rclc_synchronizer_stamp_diff(newest, oldest) <= synchronizer->slop_ns;
+}
+
+/***
+ * ring callback of each input: the new messages are matched oldest first, so that no tuple
+ * is skipped, if several messages were received in one spin.
+ */
+static
+void
+_rclc_synchronizer_ring_callback(
+  const void * const * msgs,
+  size_t size,
+  size_t new_count,
+  void * context)
+{
+  rclc_synchronizer_input_t * input = (rclc_synchronizer_input_t *) context;
+  rclc_synchronizer_t * synchronizer = input->synchronizer;
+  size_t pivot = (size_t) (input - synchronizer->inputs);
+  for (size_t n = size - new_count; n < size; n++) {
+    int64_t stamp = input->stamp(msgs[n]);
+    if (stamp <= input->last_stamp) {
+      continue;
+    }
+    if (_rclc_synchronizer_match(synchronizer, pivot, msgs[n], stamp)) {
+      synchronizer->callback(synchronizer->tuple, synchronizer->size, synchronizer->context);
+      synchronizer->matches++;
+      // drop all messages up to the matched ones
+      for (size_t i = 0; i < synchronizer->size; i++) {
+        synchronizer->inputs[i].last_stamp = synchronizer->tuple_stamps[i];
+      }
+    }
+  }
+}
+
+rcl_ret_t
+rclc_executor_add_synchronizer_input(
+  rclc_executor_t * executor,
+  rclc_synchronizer_t * synchronizer,
+  rcl_subscription_t * subscription,
+  size_t msg_size,
+  rclc_message_init_t init,
+  rclc_message_fini_t fini,
+  rclc_synchronizer_stamp_t stamp)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(synchronizer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(stamp, RCL_RET_INVALID_ARGUMENT);
+  if (synchronizer->size >= synchronizer->capacity) {
+    RCL_SET_ERROR_MSG("Buffer overflow of 'synchronizer->inputs'. Increase 'max_inputs'");
+    return RCL_RET_ERROR;
+  }
+  if ((NULL != synchronizer->executor) && (synchronizer->executor != executor)) {
+    RCL_SET_ERROR_MSG("All inputs of a synchronizer must be added to the same executor");
+    return RCL_RET_ERROR;
+  }
+
+  rclc_synchronizer_input_t * input = &synchronizer->inputs[synchronizer->size];
+  input->synchronizer = synchronizer;
+  input->subscription = subscription;
+  input->stamp = stamp;
+  input->last_stamp = INT64_MIN;
+
+  rcl_ret_t ret = rclc_executor_add_subscription_ring(
+    executor, subscription, msg_size, synchronizer->depth, init, fini,
+    _rclc_synchronizer_ring_callback, input, ON_NEW_DATA);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  synchronizer->executor = executor;
+  synchronizer->size++;
+
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Added a synchronizer input.");
+  return ret;
+}
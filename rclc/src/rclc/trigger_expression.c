@@ -0,0 +1,269 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "rclc/trigger_expression.h"
+
+#include <rcl/error_handling.h>
+
+rclc_trigger_expression_t
+rclc_trigger_expression_get_zero_initialized_expression(void)
+{
+  static rclc_trigger_expression_t null_expression = {
+    .op = RCLC_TRIGGER_ANY,
+    .groups = NULL,
+    .size = 0,
+    .capacity = 0,
+    .words = 0,
+    .masks = NULL,
+    .allocator = NULL,
+  };
+  return null_expression;
+}
+
+rcl_ret_t
+rclc_trigger_expression_init(
+  rclc_trigger_expression_t * expression,
+  rclc_trigger_operator_t op,
+  size_t max_groups,
+  size_t max_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(expression, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if ((max_groups == 0) || (max_handles == 0)) {
+    RCL_SET_ERROR_MSG("max_groups and max_handles must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  size_t words = RCLC_TRIGGER_BITMAP_WORDS(max_handles);
+  expression->groups = allocator->zero_allocate(
+    max_groups, sizeof(rclc_trigger_group_t), allocator->state);
+  if (NULL == expression->groups) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for trigger groups.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  expression->masks = allocator->zero_allocate(
+    max_groups * words, sizeof(uint64_t), allocator->state);
+  if (NULL == expression->masks) {
+    allocator->deallocate(expression->groups, allocator->state);
+    expression->groups = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for trigger masks.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < max_groups; i++) {
+    expression->groups[i].mask = &expression->masks[i * words];
+  }
+  expression->op = op;
+  expression->size = 0;
+  expression->capacity = max_groups;
+  expression->words = words;
+  expression->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rclc_trigger_expression_add_group(
+  rclc_trigger_expression_t * expression,
+  rclc_trigger_operator_t op,
+  const void * const * rcl_handles,
+  size_t size)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(expression, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handles, RCL_RET_INVALID_ARGUMENT);
+  if (size == 0) {
+    RCL_SET_ERROR_MSG("trigger group must not be empty");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < size; i++) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handles[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  if (expression->size >= expression->capacity) {
+    RCL_SET_ERROR_MSG("trigger expression has no free group");
+    return RCL_RET_ERROR;
+  }
+  rclc_trigger_group_t * group = &expression->groups[expression->size];
+  group->op = op;
+  group->rcl_handles = rcl_handles;
+  group->size = size;
+  group->complete = false;
+  expression->size++;
+  return RCL_RET_OK;
+}
+
+/***
+ * evaluates one group with word-wide operations: ALL is fulfilled, if all bits of the mask
+ * are set in the bitmap, ANY, if at least one bit of the mask is set.
+ */
+static
+bool
+_rclc_trigger_group_evaluate(
+  const rclc_trigger_group_t * group,
+  const uint64_t * ready_bitmap,
+  size_t words)
+{
+  if (group->op == RCLC_TRIGGER_ALL) {
+    if (!group->complete) {
+      return false;
+    }
+    for (size_t w = 0; w < words; w++) {
+      if ((ready_bitmap[w] & group->mask[w]) != group->mask[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  for (size_t w = 0; w < words; w++) {
+    if ((ready_bitmap[w] & group->mask[w]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+rclc_trigger_expression_evaluate(
+  const rclc_trigger_expression_t * expression,
+  const uint64_t * ready_bitmap,
+  size_t words)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(expression, "expression is NULL", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(ready_bitmap, "ready_bitmap is NULL", return false);
+  if (words > expression->words) {
+    words = expression->words;
+  }
+  for (size_t i = 0; i < expression->size; i++) {
+    bool fulfilled = _rclc_trigger_group_evaluate(&expression->groups[i], ready_bitmap, words);
+    if ((expression->op == RCLC_TRIGGER_ANY) && fulfilled) {
+      return true;
+    }
+    if ((expression->op == RCLC_TRIGGER_ALL) && !fulfilled) {
+      return false;
+    }
+  }
+  // no group decided the result: ALL of all groups is true, ANY of no group is false
+  return (expression->op == RCLC_TRIGGER_ALL) && (expression->size > 0);
+}
+
+rcl_ret_t
+rclc_trigger_expression_fini(rclc_trigger_expression_t * expression)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(expression, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != expression->allocator) {
+    expression->allocator->deallocate(expression->groups, expression->allocator->state);
+    expression->allocator->deallocate(expression->masks, expression->allocator->state);
+  }
+  expression->groups = NULL;
+  expression->masks = NULL;
+  expression->size = 0;
+  expression->capacity = 0;
+  expression->words = 0;
+  return RCL_RET_OK;
+}
+
+rclc_trigger_deadline_t
+rclc_trigger_deadline_get_zero_initialized_deadline(void)
+{
+  static rclc_trigger_deadline_t null_trigger = {
+    .inputs = {.op = RCLC_TRIGGER_ALL, .rcl_handles = NULL, .size = 0, .mask = NULL,
+      .complete = false},
+    .max_wait_ns = 0,
+    .words = 0,
+    .waiting = false,
+    .first_input_time_ns = 0,
+    .fresh = NULL,
+    .expirations = 0,
+    .allocator = NULL,
+  };
+  return null_trigger;
+}
+
+rcl_ret_t
+rclc_trigger_deadline_init(
+  rclc_trigger_deadline_t * trigger,
+  const void * const * rcl_handles,
+  size_t size,
+  uint64_t max_wait_ns,
+  size_t max_handles,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(trigger, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handles, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is NULL", return RCL_RET_INVALID_ARGUMENT);
+  if ((size == 0) || (max_handles == 0)) {
+    RCL_SET_ERROR_MSG("size and max_handles must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (max_wait_ns > (uint64_t) INT64_MAX) {
+    RCL_SET_ERROR_MSG("maximum waiting time is too large");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < size; i++) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(rcl_handles[i], RCL_RET_INVALID_ARGUMENT);
+  }
+
+  size_t words = RCLC_TRIGGER_BITMAP_WORDS(max_handles);
+  trigger->inputs.mask = allocator->zero_allocate(words, sizeof(uint64_t), allocator->state);
+  if (NULL == trigger->inputs.mask) {
+    RCL_SET_ERROR_MSG("Could not allocate memory for trigger mask.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  trigger->fresh = allocator->zero_allocate(size, sizeof(bool), allocator->state);
+  if (NULL == trigger->fresh) {
+    allocator->deallocate(trigger->inputs.mask, allocator->state);
+    trigger->inputs.mask = NULL;
+    RCL_SET_ERROR_MSG("Could not allocate memory for fresh flags.");
+    return RCL_RET_BAD_ALLOC;
+  }
+  trigger->inputs.op = RCLC_TRIGGER_ALL;
+  trigger->inputs.rcl_handles = rcl_handles;
+  trigger->inputs.size = size;
+  trigger->inputs.complete = false;
+  trigger->max_wait_ns = max_wait_ns;
+  trigger->words = words;
+  trigger->waiting = false;
+  trigger->first_input_time_ns = 0;
+  trigger->expirations = 0;
+  trigger->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+bool
+rclc_trigger_deadline_is_fresh(
+  const rclc_trigger_deadline_t * trigger,
+  const void * rcl_handle)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(trigger, "trigger is NULL", return false);
+  for (size_t i = 0; i < trigger->inputs.size; i++) {
+    if (trigger->inputs.rcl_handles[i] == rcl_handle) {
+      return trigger->fresh[i];
+    }
+  }
+  return false;
+}
+
+rcl_ret_t
+rclc_trigger_deadline_fini(rclc_trigger_deadline_t * trigger)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(trigger, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != trigger->allocator) {
+    trigger->allocator->deallocate(trigger->inputs.mask, trigger->allocator->state);
+    trigger->allocator->deallocate(trigger->fresh, trigger->allocator->state);
+  }
+  trigger->inputs.mask = NULL;
+  trigger->inputs.size = 0;
+  trigger->fresh = NULL;
+  trigger->words = 0;
+  trigger->waiting = false;
+  return RCL_RET_OK;
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2023 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <performance_test_fixture/performance_test_fixture.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "rclc/executor.h"
+
+using performance_test_fixture::PerformanceTest;
+
+// number of handles, which are added to the executor in the benchmarks
+#define BENCHMARK_HANDLE_ARGS \
+  Arg(1)->Arg(10)->Arg(50)->Arg(150)->Arg(300)->Arg(1000)
+
+static void gc_callback()
+{
+}
+
+// Executor with st.range(0) guard conditions. Guard conditions are used,
+// because they do not create entities in the DDS middleware.
+class ExecutorPerformanceTest : public PerformanceTest
+{
+public:
+  rcl_context_t context;
+  rcl_allocator_t allocator;
+  std::vector<rcl_guard_condition_t> guard_conditions;
+  rclc_executor_t executor;
+
+  void SetUp(benchmark::State & st) override
+  {
+    executor = rclc_executor_get_zero_initialized_executor();
+    context = rcl_get_zero_initialized_context();
+    allocator = rcl_get_default_allocator();
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, allocator);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    rcl_init_options_fini(&init_options);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+
+    size_t number_of_handles = get_number_of_handles(st);
+    guard_conditions.resize(number_of_handles, rcl_get_zero_initialized_guard_condition());
+    ret = rclc_executor_init(&executor, &context, number_of_handles, &allocator);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+    for (auto & gc : guard_conditions) {
+      ret = rcl_guard_condition_init(&gc, &context, rcl_guard_condition_get_default_options());
+      if (ret != RCL_RET_OK) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+      ret = rclc_executor_add_guard_condition(&executor, &gc, &gc_callback);
+      if (ret != RCL_RET_OK) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+    }
+    ret = configure_executor(st);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+    ret = rclc_executor_prepare(&executor);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+    rclc_executor_fini(&executor);
+    for (auto & gc : guard_conditions) {
+      rcl_guard_condition_fini(&gc);
+    }
+    guard_conditions.clear();
+    rcl_shutdown(&context);
+    rcl_context_fini(&context);
+  }
+
+protected:
+  virtual size_t get_number_of_handles(const benchmark::State & st)
+  {
+    return static_cast<size_t>(st.range(0));
+  }
+
+  // additional configuration of the executor before the measurement starts
+  virtual rcl_ret_t configure_executor(const benchmark::State & st)
+  {
+    (void) st;
+    return RCL_RET_OK;
+  }
+};
+
+// per-spin cost of an idle executor (no handle is ready) as function of the number of handles
+BENCHMARK_DEFINE_F(ExecutorPerformanceTest, spin_some_idle)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    rcl_ret_t ret = rclc_executor_spin_some(&executor, 0);
+    if (ret != RCL_RET_OK && ret != RCL_RET_TIMEOUT) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+  }
+}
+BENCHMARK_REGISTER_F(ExecutorPerformanceTest, spin_some_idle)->BENCHMARK_HANDLE_ARGS;
+
+// per-spin cost, if one handle is ready
+BENCHMARK_DEFINE_F(ExecutorPerformanceTest, spin_some_one_ready)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    rcl_ret_t ret = rcl_trigger_guard_condition(&guard_conditions[0]);
+    if (ret != RCL_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+    ret = rclc_executor_spin_some(&executor, 0);
+    if (ret != RCL_RET_OK && ret != RCL_RET_TIMEOUT) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+  }
+}
+BENCHMARK_REGISTER_F(ExecutorPerformanceTest, spin_some_one_ready)->BENCHMARK_HANDLE_ARGS;
+
+// per-spin cost of the scan for new data, if every 100th handle is ready: the executor
+// reads only the dense hot handle data of the handles without new data
+BENCHMARK_DEFINE_F(ExecutorPerformanceTest, spin_some_sparse_ready)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    for (size_t i = 0; i < guard_conditions.size(); i += 100) {
+      rcl_ret_t ret = rcl_trigger_guard_condition(&guard_conditions[i]);
+      if (ret != RCL_RET_OK) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+    }
+    rcl_ret_t ret = rclc_executor_spin_some(&executor, 0);
+    if (ret != RCL_RET_OK && ret != RCL_RET_TIMEOUT) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+  }
+}
+BENCHMARK_REGISTER_F(ExecutorPerformanceTest, spin_some_sparse_ready)->BENCHMARK_HANDLE_ARGS;
+
+// number of guard conditions, which become ready at once in the multi-threaded benchmarks
+#define BENCHMARK_BURST_SIZE 64
+
+static std::atomic<size_t> burst_callback_cnt{0};
+
+static void burst_gc_callback()
+{
+  burst_callback_cnt++;
+}
+
+// arguments: number of worker threads, rclc_executor_worker_scheduling_t
+static void worker_args(benchmark::internal::Benchmark * b)
+{
+  for (auto scheduling : {RCLC_WORKER_SCHEDULING_WORK_STEALING,
+      RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE})
+  {
+    for (int64_t workers : {1, 4, 8, 16}) {
+      b->Args({workers, static_cast<int64_t>(scheduling)});
+    }
+  }
+}
+
+// Multi-threaded executor with BENCHMARK_BURST_SIZE guard conditions,
+// st.range(0) worker threads and scheduling st.range(1).
+class MultiThreadedExecutorPerformanceTest : public ExecutorPerformanceTest
+{
+protected:
+  size_t get_number_of_handles(const benchmark::State & st) override
+  {
+    (void) st;
+    return BENCHMARK_BURST_SIZE;
+  }
+
+  rcl_ret_t configure_executor(const benchmark::State & st) override
+  {
+    // replace the callbacks with burst_gc_callback
+    for (size_t i = 0; i < executor.index; i++) {
+      executor.handles[i].gc_callback = &burst_gc_callback;
+    }
+    rcl_ret_t ret = rclc_executor_set_worker_scheduling(
+      &executor, static_cast<rclc_executor_worker_scheduling_t>(st.range(1)));
+    if (ret != RCL_RET_OK) {
+      return ret;
+    }
+    return rclc_executor_set_worker_threads(&executor, static_cast<size_t>(st.range(0)));
+  }
+};
+
+// all guard conditions become ready at once: time to dispatch and execute
+// BENCHMARK_BURST_SIZE short callbacks
+BENCHMARK_DEFINE_F(MultiThreadedExecutorPerformanceTest, spin_some_burst)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    burst_callback_cnt = 0;
+    for (auto & gc : guard_conditions) {
+      rcl_ret_t ret = rcl_trigger_guard_condition(&gc);
+      if (ret != RCL_RET_OK) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+    }
+    while (burst_callback_cnt < BENCHMARK_BURST_SIZE) {
+      rcl_ret_t ret = rclc_executor_spin_some(&executor, 0);
+      if (ret != RCL_RET_OK && ret != RCL_RET_TIMEOUT) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * BENCHMARK_BURST_SIZE);
+}
+BENCHMARK_REGISTER_F(MultiThreadedExecutorPerformanceTest, spin_some_burst)
+->Apply(worker_args)->UseRealTime();
@@ -17,7 +17,10 @@
 #include <example_interfaces/srv/add_two_ints.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 #include <vector>
 
@@ -863,6 +866,15 @@ TEST_F(TestDefaultExecutor, executor_remove_subscription) {
   EXPECT_EQ(executor.info.number_of_subscriptions, num_subscriptions) <<
     "number of subscriptions is expected to be two";
 
+  // test: adding the first subscription twice is rejected
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg,
+    &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_subscriptions, num_subscriptions) <<
+    "number of subscriptions is expected to be two";
+
   // test: add third subscription - execution order is 1,2,3
   rc = rclc_executor_add_subscription(
     &executor, &this->sub3, &this->sub3_msg,
@@ -934,16 +946,23 @@ TEST_F(TestDefaultExecutor, executor_remove_subscription) {
   EXPECT_EQ(executor.handles[2].subscription, &this->sub2) <<
     "expect to find sub2 in third handle";
 
-  // test: remove first handle
+  // test: remove first handle - the last handle is moved into the free slot,
+  // but the order of execution is still 3,2
   rc = rclc_executor_remove_subscription(&executor, &this->sub1);
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
   num_subscriptions = 2;
   EXPECT_EQ(executor.info.number_of_subscriptions, num_subscriptions) <<
     "number of subscriptions is expected to be two";
-  EXPECT_EQ(executor.handles[0].subscription, &this->sub3) <<
-    "expect to find sub3 in first handle";
-  EXPECT_EQ(executor.handles[1].subscription, &this->sub2) <<
-    "expect to find sub2 in second handle";
+  EXPECT_EQ(executor.handles[0].subscription, &this->sub2) <<
+    "expect to find sub2 in first handle";
+  EXPECT_EQ(executor.handles[1].subscription, &this->sub3) <<
+    "expect to find sub3 in second handle";
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[executor.dispatch_order[0]].subscription, &this->sub3) <<
+    "expect sub3 to be executed first";
+  EXPECT_EQ(executor.handles[executor.dispatch_order[1]].subscription, &this->sub2) <<
+    "expect sub2 to be executed second";
   // test: restore (push) sub1 subscription - this changes the order of excution to 3,2,1
   rc = rclc_executor_add_subscription(
     &executor, &this->sub1, &this->sub1_msg,
@@ -953,13 +972,15 @@ TEST_F(TestDefaultExecutor, executor_remove_subscription) {
   EXPECT_EQ(executor.info.number_of_subscriptions, num_subscriptions) <<
     "number of subscriptions is expected to be three";
 
-  // test: the handles are in the expected order
-  EXPECT_EQ(executor.handles[0].subscription, &this->sub3) <<
-    "expect to find sub3 in first handle";
-  EXPECT_EQ(executor.handles[1].subscription, &this->sub2) <<
-    "expect to find sub2 in second handle";
-  EXPECT_EQ(executor.handles[2].subscription, &this->sub1) <<
-    "expect to find sub1 in third handle";
+  // test: the handles are executed in the expected order
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[executor.dispatch_order[0]].subscription, &this->sub3) <<
+    "expect sub3 to be executed first";
+  EXPECT_EQ(executor.handles[executor.dispatch_order[1]].subscription, &this->sub2) <<
+    "expect sub2 to be executed second";
+  EXPECT_EQ(executor.handles[executor.dispatch_order[2]].subscription, &this->sub1) <<
+    "expect sub1 to be executed third";
 
 
   // tear down
@@ -1836,6 +1857,80 @@ TEST_F(TestDefaultExecutor, spin_period) {
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
 }
 
+static std::chrono::milliseconds _tc_spin_period_callback_duration(0);
+
+void spin_period_overrun_callback(const void * msgin)
+{
+  RCLC_UNUSED(msgin);
+  std::this_thread::sleep_for(_tc_spin_period_callback_duration);
+}
+
+TEST_F(TestDefaultExecutor, spin_period_overrun) {
+  // period of 10 ms, the first callback takes 25 ms
+  // catch-up: the second spin starts immediately, no period is skipped
+  // skip: the periods at 10 ms and 20 ms are skipped
+  rcl_ret_t rc;
+  rclc_executor_period_statistics_t statistics;
+  const uint64_t spin_period = 10000000;  // 10 ms
+  const rclc_executor_period_overrun_policy_t policies[2] =
+  {RCLC_PERIOD_OVERRUN_CATCH_UP, RCLC_PERIOD_OVERRUN_SKIP};
+
+  for (size_t p = 0; p < 2; p++) {
+    rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+    rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    rc = rclc_executor_set_timeout(&executor, 0);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    rc = rclc_executor_add_subscription(
+      &executor, &this->sub1, &this->sub1_msg, &spin_period_overrun_callback, ALWAYS);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    rc = rclc_executor_set_period_overrun_policy(&executor, policies[p]);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+    _tc_spin_period_callback_duration = std::chrono::milliseconds(25);
+    rc = rclc_executor_spin_one_period(&executor, spin_period);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    _tc_spin_period_callback_duration = std::chrono::milliseconds(0);
+    rc = rclc_executor_spin_one_period(&executor, spin_period);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+    rc = rclc_executor_get_period_statistics(&executor, &statistics);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    EXPECT_EQ(statistics.periods, (uint64_t) 2);
+    EXPECT_GE(statistics.overruns, (uint64_t) 1);
+    EXPECT_EQ(statistics.jitter_min_ns, (int64_t) 0);
+    EXPECT_EQ(statistics.jitter_total_ns, statistics.jitter_last_ns);
+    if (policies[p] == RCLC_PERIOD_OVERRUN_CATCH_UP) {
+      EXPECT_EQ(statistics.skipped_periods, (uint64_t) 0);
+      // the second spin started late, at about 25 ms instead of 10 ms
+      EXPECT_GE(statistics.jitter_max_ns, (int64_t) 10000000);
+    } else {
+      EXPECT_GE(statistics.skipped_periods, (uint64_t) 2);
+      // the second spin started on schedule at 30 ms
+      EXPECT_LT(statistics.jitter_max_ns, (int64_t) spin_period);
+    }
+
+    // invalid arguments
+    rc = rclc_executor_get_period_statistics(&executor, nullptr);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+    rcutils_reset_error();
+    rc = rclc_executor_set_period_overrun_policy(nullptr, RCLC_PERIOD_OVERRUN_SKIP);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+    rcutils_reset_error();
+
+    // reset
+    rc = rclc_executor_reset_statistics(&executor);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    rc = rclc_executor_get_period_statistics(&executor, &statistics);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    EXPECT_EQ(statistics.periods, (uint64_t) 0);
+
+    // tear down
+    rc = rclc_executor_fini(&executor);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  }
+}
+
 /*
 TEST_F(TestDefaultExecutor, semantics_RCLCPP) {
   rcl_ret_t rc;
@@ -2717,6 +2812,12 @@ TEST_F(TestDefaultExecutor, executor_test_guard_condition) {
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
   EXPECT_EQ(executor.info.number_of_guard_conditions, (size_t) 1);
 
+  // adding the same guard condition again is rejected
+  rc = rclc_executor_add_guard_condition(&executor, &guard_cond, &gc_callback);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_guard_conditions, (size_t) 1);
+
   // trigger guard condition
   rc = rcl_trigger_guard_condition(&guard_cond);
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
@@ -2804,3 +2905,1838 @@ TEST_F(TestDefaultExecutor, executor_test_remove_guard_condition) {
   rc = rclc_executor_fini(&executor);
   EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
 }
+
+TEST_F(TestDefaultExecutor, executor_test_wait_set_entities) {
+  rcl_ret_t rc;
+  rclc_executor_t executor;
+  executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 4, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // add handles with mixed types
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // rcl-handles are sorted by type and the index in the wait_set is assigned
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.wait_set_entities.number_of_subscriptions, (size_t) 3);
+  EXPECT_EQ(executor.wait_set_entities.number_of_timers, (size_t) 1);
+  EXPECT_EQ(executor.wait_set_entities.entities[0], &this->sub1);
+  EXPECT_EQ(executor.wait_set_entities.entities[1], &this->sub2);
+  EXPECT_EQ(executor.wait_set_entities.entities[2], &this->sub3);
+  EXPECT_EQ(executor.wait_set_entities.entities[3], &this->timer1);
+  EXPECT_EQ(executor.handles[0].index, (size_t) 0);
+  EXPECT_EQ(executor.handles[1].index, (size_t) 0);
+  EXPECT_EQ(executor.handles[2].index, (size_t) 1);
+  EXPECT_EQ(executor.handles[3].index, (size_t) 2);
+
+  // index is stable in consecutive spins
+  rc = rclc_executor_spin_some(&executor, 0);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[2].index, (size_t) 1);
+  EXPECT_EQ(executor.wait_set.subscriptions[0], nullptr);
+
+  // removing a handle moves the last handle into the free slot: [sub3, timer1, sub2]
+  // and updates the index of the remaining handles
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.wait_set_entities.number_of_subscriptions, (size_t) 2);
+  EXPECT_EQ(executor.wait_set_entities.entities[0], &this->sub3);
+  EXPECT_EQ(executor.wait_set_entities.entities[1], &this->sub2);
+  EXPECT_EQ(executor.wait_set_entities.entities[2], &this->timer1);
+  EXPECT_EQ(executor.handles[0].subscription, &this->sub3);
+  EXPECT_EQ(executor.handles[0].index, (size_t) 0);
+  EXPECT_EQ(executor.handles[1].timer, &this->timer1);
+  EXPECT_EQ(executor.handles[1].index, (size_t) 0);
+  EXPECT_EQ(executor.handles[2].subscription, &this->sub2);
+  EXPECT_EQ(executor.handles[2].index, (size_t) 1);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_subscription_max_takes) {
+  // publish 5 messages on pub1
+  // spin_some() with max_takes 2                    => sub1 called 2 times
+  // spin_some() with max_takes RCLC_TAKE_UNTIL_EMPTY => sub1 called 3 times
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  _results_callback_init();
+
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  // default: one message per spin
+  EXPECT_EQ(executor.handles[0].max_takes_per_spin, (size_t) 1);
+
+  // test invalid arguments
+  rc = rclc_executor_set_subscription_max_takes(nullptr, &this->sub1, 2);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_subscription_max_takes(&executor, nullptr, 2);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  // subscription not added to executor
+  rc = rclc_executor_set_subscription_max_takes(&executor, &this->sub2, 2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_subscription_max_takes(&executor, &this->sub1, 2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[0].max_takes_per_spin, (size_t) 2);
+
+  this->pub1_msg.data = 1;
+  for (unsigned int i = 0; i < 5; i++) {
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 2, _cb1_cnt);
+
+  // drain the remaining messages
+  rc = rclc_executor_set_subscription_max_takes(&executor, &this->sub1, RCLC_TAKE_UNTIL_EMPTY);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 5, _cb1_cnt);
+  EXPECT_EQ((unsigned int) 1, _cb1_int_value);
+
+  // queue is empty
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 5, _cb1_cnt);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _cb_batch_cnt = 0;
+static size_t _cb_batch_msg_cnt = 0;
+static int32_t _cb_batch_sum = 0;
+
+void batch_callback(const void * msgs, size_t count, void * context)
+{
+  const std_msgs__msg__Int32 * msg_array = (const std_msgs__msg__Int32 *) msgs;
+  _cb_batch_cnt++;
+  _cb_batch_msg_cnt = count;
+  for (size_t i = 0; i < count; i++) {
+    _cb_batch_sum += msg_array[i].data;
+  }
+  if (context != NULL) {
+    (*reinterpret_cast<unsigned int *>(context))++;
+  }
+}
+
+static unsigned int _msg_init_cnt = 0;
+static unsigned int _msg_fini_cnt = 0;
+
+bool int32_msg_init(void * msg)
+{
+  _msg_init_cnt++;
+  return std_msgs__msg__Int32__init(reinterpret_cast<std_msgs__msg__Int32 *>(msg));
+}
+
+void int32_msg_fini(void * msg)
+{
+  _msg_fini_cnt++;
+  std_msgs__msg__Int32__fini(reinterpret_cast<std_msgs__msg__Int32 *>(msg));
+}
+
+TEST_F(TestDefaultExecutor, executor_add_subscription_batch) {
+  // publish 3 messages on pub1
+  // spin_some() with capacity 2 => batch callback called once with 2 messages
+  // spin_some()                 => batch callback called once with 1 message
+  rcl_ret_t rc;
+  unsigned int context_cnt = 0;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_add_subscription_batch(
+    &executor, nullptr, sizeof(std_msgs__msg__Int32), 2, nullptr, nullptr, &batch_callback,
+    nullptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_batch(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 2, nullptr, nullptr, nullptr, nullptr,
+    ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_batch(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 0, nullptr, nullptr, &batch_callback,
+    nullptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+
+  _msg_init_cnt = 0;
+  _msg_fini_cnt = 0;
+  rc = rclc_executor_add_subscription_batch(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 2, &int32_msg_init, &int32_msg_fini,
+    &batch_callback, &context_cnt, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_msg_init_cnt, (unsigned int) 2);
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 1);
+  EXPECT_EQ(executor.handles[0].type, RCLC_SUBSCRIPTION_BATCH);
+  EXPECT_NE(executor.handles[0].data, nullptr);
+  EXPECT_EQ(executor.handles[0].data_capacity, (size_t) 2);
+
+  // handles array is full
+  rc = rclc_executor_add_subscription_batch(
+    &executor, &this->sub2, sizeof(std_msgs__msg__Int32), 2, nullptr, nullptr, &batch_callback,
+    nullptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  for (int32_t i = 1; i <= 3; i++) {
+    this->pub1_msg.data = i;
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 1, _cb_batch_cnt);
+  EXPECT_EQ((size_t) 2, _cb_batch_msg_cnt);
+  EXPECT_EQ(3, _cb_batch_sum);
+  EXPECT_EQ((unsigned int) 1, context_cnt);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 2, _cb_batch_cnt);
+  EXPECT_EQ((size_t) 1, _cb_batch_msg_cnt);
+  EXPECT_EQ(6, _cb_batch_sum);
+
+  // no new messages
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 2, _cb_batch_cnt);
+
+  // removing the subscription finalizes the messages and frees the message array
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+  EXPECT_EQ(executor.handles[0].data, nullptr);
+  EXPECT_EQ(_msg_fini_cnt, (unsigned int) 2);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+// counts the concurrent executions of the callback of one subscription
+struct mt_callback_context_t
+{
+  std::atomic<unsigned int> cnt;
+  std::atomic<unsigned int> running;
+  std::atomic<unsigned int> max_running;
+};
+
+void mt_callback(const void * msgin, void * context)
+{
+  RCLC_UNUSED(msgin);
+  mt_callback_context_t * ctx = reinterpret_cast<mt_callback_context_t *>(context);
+  unsigned int running = ++ctx->running;
+  if (running > ctx->max_running) {
+    ctx->max_running = running;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ctx->running--;
+  ctx->cnt++;
+}
+
+TEST_F(TestDefaultExecutor, executor_multi_threaded) {
+  rcl_ret_t rc;
+  mt_callback_context_t ctx1{}, ctx2{};
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+
+  // executor not initialized
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.type, RCLC_EXECUTOR_SINGLE_THREADED);
+  EXPECT_EQ(executor.worker_scheduling, RCLC_WORKER_SCHEDULING_WORK_STEALING);
+  rc = rclc_executor_add_subscription_with_context(
+    &executor, &this->sub1, &this->sub1_msg, &mt_callback, &ctx1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription_with_context(
+    &executor, &this->sub2, &this->sub2_msg, &mt_callback, &ctx2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // only RCLCPP_EXECUTOR semantics without dispatch budget is supported
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.type, RCLC_EXECUTOR_SINGLE_THREADED);
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_RCLCPP_EXECUTOR);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_dispatch_budget(&executor, RCL_MS_TO_NS(1));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_dispatch_budget(&executor, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.type, RCLC_EXECUTOR_MULTI_THREADED);
+  EXPECT_NE(executor.worker_pool, nullptr);
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_dispatch_budget(&executor, RCL_MS_TO_NS(1));
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  for (unsigned int i = 0; i < 3; i++) {
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+    rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  // spin until all messages are dispatched
+  for (unsigned int i = 0; i < 100 && (ctx1.cnt < 3 || ctx2.cnt < 3); i++) {
+    rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+
+  // stopping the worker threads waits for all running callbacks
+  rc = rclc_executor_set_worker_threads(&executor, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.type, RCLC_EXECUTOR_SINGLE_THREADED);
+  EXPECT_EQ(executor.worker_pool, nullptr);
+
+  EXPECT_EQ((unsigned int) 3, ctx1.cnt);
+  EXPECT_EQ((unsigned int) 3, ctx2.cnt);
+  // the callback of a handle is never executed concurrently
+  EXPECT_EQ((unsigned int) 1, ctx1.max_running);
+  EXPECT_EQ((unsigned int) 1, ctx2.max_running);
+
+  // same with a global queue
+  rc = rclc_executor_set_worker_scheduling(&executor, RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.worker_scheduling, RCLC_WORKER_SCHEDULING_GLOBAL_QUEUE);
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  for (unsigned int i = 0; i < 3; i++) {
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  for (unsigned int i = 0; i < 100 && ctx1.cnt < 6; i++) {
+    rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+  rc = rclc_executor_set_worker_threads(&executor, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ((unsigned int) 6, ctx1.cnt);
+  EXPECT_EQ((unsigned int) 1, ctx1.max_running);
+
+  // fini stops the worker threads
+  rc = rclc_executor_set_worker_threads(&executor, 2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.worker_pool, nullptr);
+}
+
+TEST_F(TestDefaultExecutor, executor_priority_scheduling) {
+  // add sub1, sub2, sub3 with priorities 0, 5, 5 and publish on all topics
+  // without priority scheduling: callbacks are called in the order 1 2 3
+  // with priority scheduling: callbacks are called in the order 2 3 1
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(executor.priority_scheduling);
+
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_set_handle_priority(nullptr, &this->sub2, 5);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_priority(&executor, nullptr, 5);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_priority(&executor, &this->timer1, 5);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_handle_priority(&executor, &this->sub2, 5);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_handle_priority(&executor, &this->sub3, 5);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[1].priority, 5);
+
+  // priorities are ignored without priority scheduling
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.dispatch_order[0], (size_t) 0);
+  EXPECT_EQ(executor.dispatch_order[1], (size_t) 1);
+  EXPECT_EQ(executor.dispatch_order[2], (size_t) 2);
+
+  unsigned int expected_order[TC_SPIN_SOME_MAX_MSGS] = {2, 3, 1};
+  rc = rclc_executor_set_priority_scheduling(&executor, true);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(executor.dispatch_order_is_valid);
+  EXPECT_EQ(executor.dispatch_order[0], (size_t) 1);
+  EXPECT_EQ(executor.dispatch_order[1], (size_t) 2);
+  EXPECT_EQ(executor.dispatch_order[2], (size_t) 0);
+
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_TRUE(_executor_results_compare(expected_order));
+
+  // removing a handle updates the order
+  rc = rclc_executor_remove_subscription(&executor, &this->sub2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.dispatch_order[0], (size_t) 1);
+  EXPECT_EQ(executor.dispatch_order[1], (size_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_earliest_deadline_first) {
+  // add sub1, sub2, sub3 with deadlines 100ms, 10ms and none and publish on all topics
+  // with earliest-deadline-first semantics: callbacks are called in the order 2 1 3
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.deadline_misses, (size_t) 0);
+
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_set_handle_deadline(nullptr, &this->sub1, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_deadline(&executor, nullptr, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_deadline(&executor, &this->sub1, -1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_deadline(&executor, &this->timer1, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_handle_deadline(&executor, &this->sub1, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_handle_deadline(&executor, &this->sub2, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[1].deadline, RCL_MS_TO_NS(10));
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_EARLIEST_DEADLINE_FIRST);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  unsigned int expected_order[TC_SPIN_SOME_MAX_MSGS] = {2, 1, 3};
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_TRUE(_executor_results_compare(expected_order));
+  EXPECT_EQ(executor.ready_list_size, (size_t) 3);
+
+  // a deadline of 1ns is always missed
+  rc = rclc_executor_set_handle_deadline(&executor, &this->sub3, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[2].deadline_misses, (size_t) 1);
+  EXPECT_EQ(executor.deadline_misses, (size_t) 1);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_ready_list) {
+  // add sub1, sub2, sub3 and publish only on topic 2
+  // only sub2 is in the ready list and only its callback is called
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ALWAYS);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  _results_callback_init();
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  // sub3 is in the ready list, because it is invoked ALWAYS
+  EXPECT_EQ(executor.ready_list_size, (size_t) 2);
+  EXPECT_EQ(executor.ready_list[0], (size_t) 1);
+  EXPECT_EQ(executor.ready_list[1], (size_t) 2);
+  unsigned int expected_order[TC_SPIN_SOME_MAX_MSGS] = {2, 3};
+  EXPECT_TRUE(_executor_results_compare(expected_order));
+
+  // trigger_all is not fulfilled, because sub1 and sub3 have no new data
+  rc = rclc_executor_set_trigger(&executor, rclc_executor_trigger_all, NULL);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  _results_callback_init();
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.ready_list_size, (size_t) 2);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+
+  // hot data of the handles in dispatch order
+  EXPECT_EQ(executor.hot_handles[0].handle_index, (size_t) 0);
+  EXPECT_EQ(executor.hot_handles[2].handle_index, (size_t) 2);
+  EXPECT_FALSE(executor.hot_handles[0].always);
+  EXPECT_TRUE(executor.hot_handles[2].always);
+  EXPECT_TRUE(executor.hot_handles[1].wait_set_entry != nullptr);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_remove_handle_keeps_wait_set) {
+  // removing a handle neither re-initializes the wait_set nor changes the processing order
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 10, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(rcl_wait_set_is_valid(&executor.wait_set));
+
+  // the timer is moved into the slot of sub1
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(rcl_wait_set_is_valid(&executor.wait_set));
+  EXPECT_FALSE(executor.wait_set_entities_is_valid);
+  EXPECT_EQ(executor.index, (size_t) 3);
+  EXPECT_EQ(executor.handles[0].timer, &this->timer1);
+
+  // the moved handle can still be found
+  rc = rclc_executor_set_handle_priority(&executor, &this->timer1, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[0].priority, 1);
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  unsigned int expected_order[TC_SPIN_SOME_MAX_MSGS] = {2, 3};
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_TRUE(executor.wait_set_entities_is_valid);
+  EXPECT_EQ(executor.wait_set_entities.number_of_subscriptions, (size_t) 2);
+  EXPECT_EQ(executor.handles[executor.dispatch_order[0]].subscription, &this->sub2);
+  EXPECT_EQ(executor.handles[executor.dispatch_order[2]].timer, &this->timer1);
+  EXPECT_TRUE(_executor_results_compare(expected_order));
+
+  // remove all handles
+  rc = rclc_executor_remove_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_remove_subscription(&executor, &this->sub3);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_remove_subscription(&executor, &this->sub2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.index, (size_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_add_subscription_loaned) {
+  // the message is received as loan or, if the middleware does not support loans,
+  // copied into sub1_msg
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  int32_t sub_context_value = 0;
+  void * sub_context_ptr = reinterpret_cast<void *>( &sub_context_value );
+
+  // test invalid arguments
+  rc = rclc_executor_add_subscription_loaned(
+    NULL, &this->sub1, &this->sub1_msg, &int32_callback_with_context,
+    sub_context_ptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_loaned(
+    &executor, NULL, &this->sub1_msg, &int32_callback_with_context,
+    sub_context_ptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_loaned(
+    &executor, &this->sub1, NULL, &int32_callback_with_context,
+    sub_context_ptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_loaned(
+    &executor, &this->sub1, &this->sub1_msg, NULL,
+    sub_context_ptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+
+  rc = rclc_executor_add_subscription_loaned(
+    &executor, &this->sub1, &this->sub1_msg, &int32_callback_with_context,
+    sub_context_ptr, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 1);
+  EXPECT_EQ(executor.handles[0].type, RCLC_SUBSCRIPTION_LOANED);
+
+  this->pub1_msg.data = 42;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(sub_context_value, 42);
+  // the loan has been returned after the callback
+  EXPECT_EQ(executor.handles[0].data_loaned, nullptr);
+
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _cb_serialized_cnt = 0;
+static size_t _cb_serialized_length = 0;
+
+void serialized_callback(const rcl_serialized_message_t * msg, void * context)
+{
+  RCLC_UNUSED(context);
+  _cb_serialized_cnt++;
+  if (msg != NULL) {
+    _cb_serialized_length = msg->buffer_length;
+  }
+}
+
+TEST_F(TestDefaultExecutor, executor_add_subscription_serialized) {
+  // the callback receives the CDR bytes of the message
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_add_subscription_serialized(
+    NULL, &this->sub1, 16, &serialized_callback, NULL, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_serialized(
+    &executor, NULL, 16, &serialized_callback, NULL, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_serialized(
+    &executor, &this->sub1, 16, NULL, NULL, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // initial capacity of one byte: the buffer has to grow
+  rc = rclc_executor_add_subscription_serialized(
+    &executor, &this->sub1, 1, &serialized_callback, NULL, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 1);
+  EXPECT_EQ(executor.handles[0].type, RCLC_SUBSCRIPTION_SERIALIZED);
+
+  _cb_serialized_cnt = 0;
+  _cb_serialized_length = 0;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_serialized_cnt, (unsigned int) 1);
+  // CDR encapsulation header and one int32
+  EXPECT_GE(_cb_serialized_length, (size_t) 8);
+  const rcl_serialized_message_t * msg =
+    reinterpret_cast<const rcl_serialized_message_t *>(executor.handles[0].data);
+  EXPECT_GE(msg->buffer_capacity, msg->buffer_length);
+
+  // removing the subscription frees the buffer
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[0].data, nullptr);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _cb_ring_cnt = 0;
+static size_t _cb_ring_new_cnt = 0;
+static std::vector<int32_t> _cb_ring_data;
+
+void ring_callback(const void * const * msgs, size_t count, size_t new_count, void * context)
+{
+  RCLC_UNUSED(context);
+  _cb_ring_cnt++;
+  _cb_ring_new_cnt = new_count;
+  _cb_ring_data.clear();
+  for (size_t i = 0; i < count; i++) {
+    _cb_ring_data.push_back(reinterpret_cast<const std_msgs__msg__Int32 *>(msgs[i])->data);
+  }
+}
+
+TEST_F(TestDefaultExecutor, executor_add_subscription_ring) {
+  // ring of depth 3 with LET semantics
+  // publish 1, 2    => callback with [1, 2], 2 new messages
+  // publish 3, 4    => callback with [2, 3, 4], 2 new messages
+  // no new messages => callback (ALWAYS) with [2, 3, 4], 0 new messages
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_add_subscription_ring(
+    &executor, nullptr, sizeof(std_msgs__msg__Int32), 3, nullptr, nullptr,
+    &ring_callback, nullptr, ALWAYS);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_ring(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 3, nullptr, nullptr, nullptr,
+    nullptr, ALWAYS);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_subscription_ring(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 0, nullptr, nullptr,
+    &ring_callback, nullptr, ALWAYS);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+
+  _msg_init_cnt = 0;
+  _msg_fini_cnt = 0;
+  rc = rclc_executor_add_subscription_ring(
+    &executor, &this->sub1, sizeof(std_msgs__msg__Int32), 3, &int32_msg_init, &int32_msg_fini,
+    &ring_callback, nullptr, ALWAYS);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_msg_init_cnt, (unsigned int) 3);
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 1);
+  EXPECT_EQ(executor.handles[0].type, RCLC_SUBSCRIPTION_RING);
+  EXPECT_NE(executor.handles[0].data, nullptr);
+  EXPECT_NE(executor.handles[0].data_ring_snapshot, nullptr);
+  EXPECT_EQ(executor.handles[0].data_capacity, (size_t) 3);
+
+  _cb_ring_cnt = 0;
+  for (int32_t i = 1; i <= 2; i++) {
+    this->pub1_msg.data = i;
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_ring_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb_ring_new_cnt, (size_t) 2);
+  EXPECT_EQ(_cb_ring_data, std::vector<int32_t>({1, 2}));
+
+  for (int32_t i = 3; i <= 4; i++) {
+    this->pub1_msg.data = i;
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_ring_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cb_ring_new_cnt, (size_t) 2);
+  EXPECT_EQ(_cb_ring_data, std::vector<int32_t>({2, 3, 4}));
+
+  // no new messages
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_ring_cnt, (unsigned int) 3);
+  EXPECT_EQ(_cb_ring_new_cnt, (size_t) 0);
+  EXPECT_EQ(_cb_ring_data, std::vector<int32_t>({2, 3, 4}));
+
+  // removing the subscription finalizes the messages and frees the message ring
+  rc = rclc_executor_remove_subscription(&executor, &this->sub1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.handles[0].data, nullptr);
+  EXPECT_EQ(_msg_fini_cnt, (unsigned int) 3);
+  EXPECT_EQ(executor.handles[0].data_ring_snapshot, nullptr);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_statistics) {
+  // sub1 (ON_NEW_DATA) and sub2 (ALWAYS), publish only on pub1
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rclc_executor_handle_statistics_t handle_statistics;
+  rclc_executor_spin_statistics_t spin_statistics;
+  rc = rclc_executor_enable_statistics(nullptr, true);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_handle_statistics(&executor, nullptr, &handle_statistics);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub1, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_spin_statistics(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_reset_statistics(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  // handle not added to the executor
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub2, &handle_statistics);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // handles, which are added after enabling, record statistics too
+  rc = rclc_executor_enable_statistics(&executor, true);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(executor.monitoring.statistics_enabled);
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ALWAYS);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub1, &handle_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(handle_statistics.invocations, (uint64_t) 1);
+  EXPECT_LE(handle_statistics.callback_time_min_ns, handle_statistics.callback_time_mean_ns);
+  EXPECT_LE(handle_statistics.callback_time_mean_ns, handle_statistics.callback_time_max_ns);
+  uint64_t histogram_count = 0;
+  for (size_t i = 0; i < RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE; i++) {
+    histogram_count += handle_statistics.callback_time_histogram[i];
+  }
+  EXPECT_EQ(histogram_count, (uint64_t) 1);
+
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub2, &handle_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(handle_statistics.invocations, (uint64_t) 2);
+
+  rc = rclc_executor_get_spin_statistics(&executor, &spin_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(spin_statistics.spins, (uint64_t) 2);
+  EXPECT_LE(spin_statistics.wait_time_max_ns, spin_statistics.wait_time_total_ns);
+  EXPECT_LE(spin_statistics.dispatch_time_max_ns, spin_statistics.dispatch_time_total_ns);
+
+  // reset
+  rc = rclc_executor_reset_statistics(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub2, &handle_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(handle_statistics.invocations, (uint64_t) 0);
+  EXPECT_EQ(handle_statistics.callback_time_min_ns, (uint64_t) 0);
+  rc = rclc_executor_get_spin_statistics(&executor, &spin_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(spin_statistics.spins, (uint64_t) 0);
+
+  // no statistics are recorded, if disabled
+  rc = rclc_executor_enable_statistics(&executor, false);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  rc = rclc_executor_get_handle_statistics(&executor, &this->sub2, &handle_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(handle_statistics.invocations, (uint64_t) 0);
+  rc = rclc_executor_get_spin_statistics(&executor, &spin_statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(spin_statistics.spins, (uint64_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_trace) {
+  // record the events of one spin, in which sub1 receives a message, and dump them
+  rcl_ret_t rc;
+  const char * trace_path = "rclc_test_executor_trace.bin";
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_enable_trace(nullptr, 64);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_trace(&executor, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_dump_trace(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  // tracing is not enabled
+  rc = rclc_executor_dump_trace(&executor, trace_path);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_enable_trace(&executor, 64);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_NE(executor.monitoring.trace, nullptr);
+
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+
+  rc = rclc_executor_dump_trace(&executor, trace_path);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // events: spin start, wait return, trigger, take, callback start, callback end
+  FILE * file = fopen(trace_path, "rb");
+  ASSERT_NE(file, nullptr);
+  rclc_executor_trace_file_header_t header;
+  ASSERT_EQ(fread(&header, sizeof(header), 1, file), (size_t) 1);
+  EXPECT_EQ(memcmp(header.magic, RCLC_EXECUTOR_TRACE_MAGIC, sizeof(header.magic)), 0);
+  EXPECT_EQ(header.event_size, sizeof(rclc_executor_trace_event_t));
+  EXPECT_EQ(header.capacity, (uint32_t) 64);
+  EXPECT_EQ(header.event_count, (uint64_t) 6);
+  EXPECT_EQ(header.dropped_count, (uint64_t) 0);
+  std::vector<rclc_executor_trace_event_t> events(header.event_count);
+  ASSERT_EQ(
+    fread(events.data(), sizeof(rclc_executor_trace_event_t), events.size(), file),
+    events.size());
+  fclose(file);
+  remove(trace_path);
+
+  uint32_t handle_id = (uint32_t) executor.handles[0].registration_number;
+  EXPECT_EQ(events[0].type, (uint32_t) RCLC_EXECUTOR_TRACE_SPIN_START);
+  EXPECT_EQ(events[1].type, (uint32_t) RCLC_EXECUTOR_TRACE_WAIT_RETURN);
+  EXPECT_EQ(events[2].type, (uint32_t) RCLC_EXECUTOR_TRACE_TRIGGER);
+  EXPECT_EQ(events[2].value, 1);
+  EXPECT_EQ(events[3].type, (uint32_t) RCLC_EXECUTOR_TRACE_TAKE);
+  EXPECT_EQ(events[3].handle_id, handle_id);
+  EXPECT_EQ(events[4].type, (uint32_t) RCLC_EXECUTOR_TRACE_CALLBACK_START);
+  EXPECT_EQ(events[4].handle_id, handle_id);
+  EXPECT_EQ(events[5].type, (uint32_t) RCLC_EXECUTOR_TRACE_CALLBACK_END);
+  EXPECT_EQ(events[5].handle_id, handle_id);
+  for (size_t i = 1; i < events.size(); i++) {
+    EXPECT_LE(events[i - 1].timestamp_ns, events[i].timestamp_ns);
+  }
+
+  rc = rclc_executor_disable_trace(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.monitoring.trace, nullptr);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_tickless_wait) {
+  rcl_ret_t rc;
+  uint64_t timeout_ns = 0;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+
+  // test invalid arguments
+  rc = rclc_executor_set_tickless_wait(nullptr, true, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_tickless_wait(&executor, true, 0);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_wait_timeout(nullptr, &timeout_ns);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // disabled: fixed timeout
+  rc = rclc_executor_set_timeout(&executor, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(timeout_ns, RCL_MS_TO_NS(10));
+
+  // no timer: bounded by the maximum timeout or waiting forever
+  rc = rclc_executor_set_tickless_wait(&executor, true, RCL_MS_TO_NS(500));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(timeout_ns, RCL_MS_TO_NS(500));
+  rc = rclc_executor_set_tickless_wait(&executor, true, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(timeout_ns, RCLC_EXECUTOR_WAIT_FOREVER);
+
+  // timer1 (period 100ms): the timers are not scanned, rcl_wait limits the timeout
+  rc = rcl_timer_reset(&this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_timer(&executor, &this->timer1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(timeout_ns, RCLC_EXECUTOR_WAIT_FOREVER);
+  rc = rclc_executor_set_tickless_wait(&executor, true, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(timeout_ns, RCL_MS_TO_NS(20));
+
+  // one spin without timeout is woken up by rcl_wait for the timer and calls it
+  rc = rclc_executor_set_tickless_wait(&executor, true, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  _cbt_cnt = 0;
+  for (size_t i = 0; (i < 3) && (_cbt_cnt == 0); i++) {
+    rc = rclc_executor_get_wait_timeout(&executor, &timeout_ns);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    EXPECT_EQ(timeout_ns, RCLC_EXECUTOR_WAIT_FOREVER);
+    rc = rclc_executor_spin_some(&executor, timeout_ns);
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(_cbt_cnt, (unsigned int) 1);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _wheel_timer_cnt[4] = {0, 0, 0, 0};
+static rclc_executor_t * _wheel_timer_executor = nullptr;
+
+static void wheel_timer_callback(rclc_wheel_timer_t * timer, void * context)
+{
+  RCLC_UNUSED(timer);
+  _wheel_timer_cnt[*static_cast<unsigned int *>(context)]++;
+}
+
+static void wheel_timer_restart_callback(rclc_wheel_timer_t * timer, void * context)
+{
+  wheel_timer_callback(timer, context);
+  // one-shot timer, which restarts itself twice
+  if (_wheel_timer_cnt[*static_cast<unsigned int *>(context)] < 3) {
+    rclc_executor_start_wheel_timer(_wheel_timer_executor, timer);
+  }
+}
+
+TEST_F(TestDefaultExecutor, executor_timer_wheel) {
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rclc_wheel_timer_t timer;
+  unsigned int id[4] = {0, 1, 2, 3};
+
+  // test invalid arguments
+  rc = rclc_wheel_timer_init(nullptr, RCL_MS_TO_NS(20), true, wheel_timer_callback, &id[0]);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_wheel_timer_init(&timer, 0, true, wheel_timer_callback, &id[0]);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_wheel_timer_init(&timer, RCL_MS_TO_NS(20), true, nullptr, &id[0]);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_wheel_timer_init(&timer, RCL_MS_TO_NS(20), true, wheel_timer_callback, &id[0]);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  // timer wheel is not enabled
+  rc = rclc_executor_start_wheel_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_timer_wheel(&executor, nullptr, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_enable_timer_wheel(&executor, &this->clock, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_enable_timer_wheel(&executor, &this->clock, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_enable_timer_wheel(&executor, &this->clock, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  // the timer wheel occupies one handle
+  EXPECT_EQ(executor.index, (size_t) 1);
+  EXPECT_EQ(executor.info.number_of_timers, (size_t) 1);
+  // the rcl timer of the wheel is only armed, while wheel timers are started
+  rcl_timer_t * wheel_rcl_timer = executor.handles[0].timer;
+  bool canceled = false;
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(canceled);
+
+  // many wheel timers, which are started and canceled again, do not expire
+  const size_t number_of_timers = 500;
+  std::vector<rclc_wheel_timer_t> timers(number_of_timers);
+  for (size_t i = 0; i < number_of_timers; i++) {
+    rc = rclc_wheel_timer_init(
+      &timers[i], RCL_MS_TO_NS(10 * (i + 1)), true, wheel_timer_callback, &id[3]);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    rc = rclc_executor_start_wheel_timer(&executor, &timers[i]);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  }
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(canceled);
+  for (size_t i = 0; i < number_of_timers; i++) {
+    rc = rclc_executor_cancel_wheel_timer(&executor, &timers[i]);
+    EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+    EXPECT_FALSE(timers[i].active);
+  }
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(canceled);
+
+  // periodic timer (20ms), one-shot timer (50ms) and self-restarting one-shot timer (30ms)
+  rclc_wheel_timer_t one_shot, restart;
+  rc = rclc_wheel_timer_init(&one_shot, RCL_MS_TO_NS(50), false, wheel_timer_callback, &id[1]);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_wheel_timer_init(
+    &restart, RCL_MS_TO_NS(30), false, wheel_timer_restart_callback, &id[2]);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  _wheel_timer_executor = &executor;
+  memset(_wheel_timer_cnt, 0, sizeof(_wheel_timer_cnt));
+  rc = rclc_executor_start_wheel_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_start_wheel_timer(&executor, &one_shot);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_start_wheel_timer(&executor, &restart);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(210);
+  while (std::chrono::steady_clock::now() < end) {
+    rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+  // about 10 periods of the periodic timer, depending on the scheduling of the test
+  EXPECT_GE(_wheel_timer_cnt[0], (unsigned int) 8);
+  EXPECT_LE(_wheel_timer_cnt[0], (unsigned int) 11);
+  EXPECT_EQ(_wheel_timer_cnt[1], (unsigned int) 1);
+  EXPECT_FALSE(one_shot.active);
+  EXPECT_EQ(_wheel_timer_cnt[2], (unsigned int) 3);
+  EXPECT_EQ(_wheel_timer_cnt[3], (unsigned int) 0);
+  EXPECT_TRUE(timer.active);
+
+  // after the one-shot timers expired, canceling the last timer cancels the rcl timer
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(canceled);
+  rc = rclc_executor_cancel_wheel_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_TRUE(canceled);
+  // restarting the timer re-arms the rcl timer
+  rc = rclc_executor_start_wheel_timer(&executor, &timer);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_timer_is_canceled(wheel_rcl_timer, &canceled);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(canceled);
+  unsigned int cnt = _wheel_timer_cnt[0];
+  end = std::chrono::steady_clock::now() + std::chrono::milliseconds(70);
+  while (std::chrono::steady_clock::now() < end) {
+    rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+  EXPECT_GE(_wheel_timer_cnt[0], cnt + 2);
+  EXPECT_TRUE(timer.active);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(timer.active);
+  _wheel_timer_executor = nullptr;
+}
+
+TEST_F(TestDefaultExecutor, executor_busy_poll) {
+  rcl_ret_t rc;
+  rclc_executor_busy_poll_statistics_t statistics;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 1, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_set_busy_poll(nullptr, RCL_MS_TO_NS(5));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_busy_poll(&executor, UINT64_MAX);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_busy_poll_statistics(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_busy_poll(&executor, RCL_MS_TO_NS(5));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // no data: the executor polls during the window and then blocks until the timeout
+  _cb1_cnt = 0;
+  rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_busy_poll_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_GE(statistics.polls, (uint64_t) 1);
+  EXPECT_EQ(statistics.busy_poll_hits, (uint64_t) 0);
+  EXPECT_EQ(statistics.blocking_waits, (uint64_t) 1);
+  EXPECT_EQ(statistics.blocking_wakeups, (uint64_t) 0);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 0);
+
+  // the timeout is shorter than the window: no blocking wait
+  rc = rclc_executor_spin_some(&executor, RCL_MS_TO_NS(1));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_busy_poll_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.blocking_waits, (uint64_t) 1);
+
+  // new data is found by polling
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_busy_poll_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.busy_poll_hits, (uint64_t) 1);
+  EXPECT_EQ(statistics.blocking_waits, (uint64_t) 1);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+
+  rc = rclc_executor_reset_statistics(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_busy_poll_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.polls, (uint64_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, executor_dispatch_budget) {
+  // add sub1, sub2, sub3 and publish on all topics. With a budget of 1ns only one callback
+  // is executed per spin, the other ready handles are deferred to the next spin.
+  rcl_ret_t rc;
+  rclc_executor_budget_statistics_t statistics;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_set_dispatch_budget(nullptr, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_dispatch_budget(&executor, UINT64_MAX);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_budget_statistics(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_spin_some_with_budget(nullptr, rclc_test_timeout_ns, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_dispatch_budget(&executor, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+  EXPECT_EQ(_cb3_cnt, (unsigned int) 0);
+  EXPECT_EQ(executor.deferred_list_size, (size_t) 2);
+  rc = rclc_executor_get_budget_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.exhausted_spins, (uint64_t) 1);
+  EXPECT_EQ(statistics.deferred_handles, (uint64_t) 2);
+  EXPECT_EQ(statistics.deferred_handles_last, (size_t) 2);
+
+  // the deferred handles are executed first in the next spins
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb3_cnt, (unsigned int) 0);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb3_cnt, (unsigned int) 1);
+  EXPECT_EQ(executor.deferred_list_size, (size_t) 0);
+  rc = rclc_executor_get_budget_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.exhausted_spins, (uint64_t) 2);
+  EXPECT_EQ(statistics.deferred_handles, (uint64_t) 3);
+
+  // a subscription, which takes all messages per spin, stops taking when the budget is used
+  // up, the remaining messages are taken in the next spins
+  rc = rclc_executor_set_subscription_max_takes(&executor, &this->sub1, RCLC_TAKE_UNTIL_EMPTY);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  _results_callback_init();
+  for (unsigned int i = 0; i < 3; i++) {
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  for (unsigned int i = 0; i < 10 && _cb1_cnt < 3; i++) {
+    rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+    EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 3);
+  rc = rclc_executor_set_subscription_max_takes(&executor, &this->sub1, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // without budget for one spin all ready handles are executed
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some_with_budget(&executor, rclc_test_timeout_ns, 0);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(executor.dispatch_budget_ns, (uint64_t) 1);
+
+  rc = rclc_executor_reset_statistics(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_get_budget_statistics(&executor, &statistics);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(statistics.exhausted_spins, (uint64_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _overrun_cnt = 0;
+static const void * _overrun_rcl_handle = nullptr;
+static uint64_t _overrun_duration_ns = 0;
+
+static
+void
+_overrun_callback(const void * rcl_handle, uint64_t duration_ns, uint64_t wcet_ns, void * context)
+{
+  RCLC_UNUSED(wcet_ns);
+  _overrun_cnt++;
+  _overrun_rcl_handle = rcl_handle;
+  _overrun_duration_ns = duration_ns;
+  (*static_cast<unsigned int *>(context))++;
+}
+
+TEST_F(TestDefaultExecutor, executor_wcet_overrun) {
+  // sub1 with a WCET of 1ns always overruns, sub2 is not monitored
+  rcl_ret_t rc;
+  uint64_t overruns = 0;
+  uint64_t worst_ns = 0;
+  unsigned int context = 0;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_executor_set_handle_wcet(nullptr, &this->sub1, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_wcet(&executor, nullptr, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_handle_wcet(&executor, &this->sub2, 1);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_overrun_callback(nullptr, &_overrun_callback, &context);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_handle_wcet_overruns(&executor, &this->sub1, nullptr, &worst_ns);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_get_handle_wcet_overruns(&executor, &this->sub2, &overruns, &worst_ns);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  rc = rclc_executor_set_handle_wcet(&executor, &this->sub1, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_overrun_callback(&executor, &_overrun_callback, &context);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.monitoring.overrun_callback, &_overrun_callback);
+  // the overrun callback is shared by all handles, also by handles added after it was set
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  _results_callback_init();
+  _overrun_cnt = 0;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(_overrun_cnt, (unsigned int) 1);
+  EXPECT_EQ(context, (unsigned int) 1);
+  EXPECT_EQ(_overrun_rcl_handle, &this->sub1);
+  EXPECT_GT(_overrun_duration_ns, (uint64_t) 1);
+
+  rc = rclc_executor_get_handle_wcet_overruns(&executor, &this->sub1, &overruns, &worst_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(overruns, (uint64_t) 1);
+  EXPECT_EQ(worst_ns, _overrun_duration_ns);
+  rc = rclc_executor_get_handle_wcet_overruns(&executor, &this->sub2, &overruns, &worst_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(overruns, (uint64_t) 0);
+  EXPECT_EQ(worst_ns, (uint64_t) 0);
+
+  // a large WCET is not overrun
+  rc = rclc_executor_set_handle_wcet(&executor, &this->sub1, RCL_S_TO_NS(10));
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 2);
+  EXPECT_EQ(_overrun_cnt, (unsigned int) 1);
+  rc = rclc_executor_get_handle_wcet_overruns(&executor, &this->sub1, &overruns, &worst_ns);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(overruns, (uint64_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, trigger_expression) {
+  // trigger expression: (A and B) or C
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub3, &this->sub3_msg, &CALLBACK_3, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  const void * group_ab[] = {&this->sub1, &this->sub2};
+  const void * group_c[] = {&this->sub3};
+  rclc_trigger_expression_t expression =
+    rclc_trigger_expression_get_zero_initialized_expression();
+  rc = rclc_trigger_expression_init(&expression, RCLC_TRIGGER_ANY, 2, 3, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // test invalid arguments
+  rc = rclc_trigger_expression_add_group(&expression, RCLC_TRIGGER_ALL, group_ab, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_trigger_expression_add_group(&expression, RCLC_TRIGGER_ALL, nullptr, 2);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_trigger_expression(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_trigger_expression_add_group(&expression, RCLC_TRIGGER_ALL, group_ab, 2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_trigger_expression_add_group(&expression, RCLC_TRIGGER_ALL, group_c, 1);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_trigger_expression_add_group(&expression, RCLC_TRIGGER_ANY, group_c, 1);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_trigger_expression(&executor, &expression);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(expression.groups[0].mask[0], (uint64_t) 0x3);
+  EXPECT_EQ(expression.groups[1].mask[0], (uint64_t) 0x4);
+
+  // A only: not triggered
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 0);
+
+  // A and C: triggered by C
+  rc = rcl_publish(&this->pub3, &this->pub3_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub3 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+  EXPECT_EQ(_cb3_cnt, (unsigned int) 1);
+
+  // B only: not triggered, then A and B: triggered
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb3_cnt, (unsigned int) 1);
+
+  // after removing B, the group (A and B) is never fulfilled and C moves in the handle array
+  rc = rclc_executor_remove_subscription(&executor, &this->sub2);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_prepare(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_FALSE(expression.groups[0].complete);
+  EXPECT_EQ(expression.groups[1].mask[0], (uint64_t) 0x2);
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 2);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_trigger_expression_fini(&expression);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultExecutor, trigger_deadline) {
+  // trigger on A and B with a maximum waiting time of 100ms
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub1, &this->sub1_msg, &CALLBACK_1, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_subscription(
+    &executor, &this->sub2, &this->sub2_msg, &CALLBACK_2, ON_NEW_DATA);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  const void * inputs[] = {&this->sub1, &this->sub2};
+  rclc_trigger_deadline_t trigger = rclc_trigger_deadline_get_zero_initialized_deadline();
+
+  // test invalid arguments
+  rc = rclc_trigger_deadline_init(&trigger, inputs, 0, RCL_MS_TO_NS(100), 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_trigger_deadline_init(&trigger, inputs, 2, UINT64_MAX, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_set_trigger_deadline(&executor, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_trigger_deadline_init(&trigger, inputs, 2, RCL_MS_TO_NS(100), 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_trigger_deadline(&executor, &trigger);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  // A only: the trigger waits for B
+  _results_callback_init();
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 0);
+  EXPECT_TRUE(trigger.waiting);
+
+  // the maximum waiting time has elapsed: A is processed without B
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 0);
+  EXPECT_EQ(trigger.expirations, (uint64_t) 1);
+  EXPECT_TRUE(rclc_trigger_deadline_is_fresh(&trigger, &this->sub1));
+  EXPECT_FALSE(rclc_trigger_deadline_is_fresh(&trigger, &this->sub2));
+  EXPECT_FALSE(rclc_trigger_deadline_is_fresh(&trigger, &this->sub3));
+
+  // A and B: processed immediately
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub1 did not publish!";
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " pub2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_EQ(_cb1_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cb2_cnt, (unsigned int) 1);
+  EXPECT_EQ(trigger.expirations, (uint64_t) 1);
+  EXPECT_TRUE(rclc_trigger_deadline_is_fresh(&trigger, &this->sub1));
+  EXPECT_TRUE(rclc_trigger_deadline_is_fresh(&trigger, &this->sub2));
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_trigger_deadline_fini(&trigger);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
+
+static unsigned int _cb_sync_cnt = 0;
+static std::vector<int32_t> _cb_sync_data;
+
+// time stamp of the test messages: the data in milliseconds
+int64_t sync_stamp(const void * msg)
+{
+  return RCL_MS_TO_NS(reinterpret_cast<const std_msgs__msg__Int32 *>(msg)->data);
+}
+
+void sync_callback(const void * const * msgs, size_t size, void * context)
+{
+  RCLC_UNUSED(context);
+  _cb_sync_cnt++;
+  _cb_sync_data.clear();
+  for (size_t i = 0; i < size; i++) {
+    _cb_sync_data.push_back(reinterpret_cast<const std_msgs__msg__Int32 *>(msgs[i])->data);
+  }
+}
+
+TEST_F(TestDefaultExecutor, executor_synchronizer) {
+  // synchronizer of A and B with depth 3 and a slop of 10ms
+  // A: 100, 200     B: 195    => tuple (200, 195), 100 is dropped
+  // A: 300          B: 350    => no tuple
+  // B: 305                    => tuple (300, 305)
+  rcl_ret_t rc;
+  rclc_executor_t executor = rclc_executor_get_zero_initialized_executor();
+  rc = rclc_executor_init(&executor, &this->context, 2, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_set_semantics(&executor, RCLC_SEMANTICS_LOGICAL_EXECUTION_TIME);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+
+  rclc_synchronizer_t sync = rclc_synchronizer_get_zero_initialized_synchronizer();
+
+  // test invalid arguments
+  rc = rclc_synchronizer_init(
+    &sync, 2, 0, RCL_MS_TO_NS(10), &sync_callback, nullptr, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_synchronizer_init(&sync, 2, 3, RCL_MS_TO_NS(10), nullptr, nullptr, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  rc = rclc_synchronizer_init(
+    &sync, 2, 3, RCL_MS_TO_NS(10), &sync_callback, nullptr, this->allocator_ptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_synchronizer_input(
+    &executor, &sync, &this->sub1, sizeof(std_msgs__msg__Int32), nullptr, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_executor_add_synchronizer_input(
+    &executor, &sync, &this->sub1, sizeof(std_msgs__msg__Int32), nullptr, nullptr,
+    &sync_stamp);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_synchronizer_input(
+    &executor, &sync, &this->sub2, sizeof(std_msgs__msg__Int32), nullptr, nullptr,
+    &sync_stamp);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  rc = rclc_executor_add_synchronizer_input(
+    &executor, &sync, &this->sub3, sizeof(std_msgs__msg__Int32), nullptr, nullptr,
+    &sync_stamp);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 2);
+  EXPECT_EQ(executor.handles[0].type, RCLC_SUBSCRIPTION_RING);
+  EXPECT_EQ(executor.handles[1].type, RCLC_SUBSCRIPTION_RING);
+
+  _cb_sync_cnt = 0;
+  for (int32_t i : {100, 200}) {
+    this->pub1_msg.data = i;
+    rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+    EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  }
+  this->pub2_msg.data = 195;
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_sync_cnt, (unsigned int) 1);
+  EXPECT_EQ(_cb_sync_data, std::vector<int32_t>({200, 195}));
+
+  this->pub1_msg.data = 300;
+  rc = rcl_publish(&this->pub1, &this->pub1_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher1 did not publish!";
+  this->pub2_msg.data = 350;
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_sync_cnt, (unsigned int) 1);
+
+  this->pub2_msg.data = 305;
+  rc = rcl_publish(&this->pub2, &this->pub2_msg, nullptr);
+  EXPECT_EQ(RCL_RET_OK, rc) << " publisher2 did not publish!";
+  std::this_thread::sleep_for(rclc_test_sleep_time);
+  rc = rclc_executor_spin_some(&executor, rclc_test_timeout_ns);
+  EXPECT_TRUE((RCL_RET_OK == rc) || (RCL_RET_TIMEOUT == rc)) << rcl_get_error_string().str;
+  EXPECT_EQ(_cb_sync_cnt, (unsigned int) 2);
+  EXPECT_EQ(_cb_sync_data, std::vector<int32_t>({300, 305}));
+  EXPECT_EQ(sync.matches, (uint64_t) 2);
+
+  // finalizing the synchronizer removes its inputs from the executor
+  rc = rclc_synchronizer_fini(&sync);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+  EXPECT_EQ(executor.info.number_of_subscriptions, (size_t) 0);
+
+  // tear down
+  rc = rclc_executor_fini(&executor);
+  EXPECT_EQ(RCL_RET_OK, rc) << rcl_get_error_string().str;
+}
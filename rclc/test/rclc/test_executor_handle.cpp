@@ -58,6 +58,11 @@ TEST(Test, executor_handle_init) {
   EXPECT_EQ(handle.index, max_handles);
   EXPECT_EQ(handle.initialized, false);
   EXPECT_EQ(handle.data_available, false);
+  EXPECT_EQ(handle.max_takes_per_spin, (size_t) 1);
+  EXPECT_EQ(handle.priority, 0);
+  EXPECT_EQ(handle.deadline, 0);
+  EXPECT_EQ(handle.deadline_misses, (size_t) 0);
+  EXPECT_EQ(handle.statistics.invocations, (uint64_t) 0);
 
   // test null pointer
   rc = rclc_executor_handle_init(NULL, max_handles);
@@ -65,6 +70,35 @@ TEST(Test, executor_handle_init) {
   rcutils_reset_error();
 }
 
+TEST(Test, executor_handle_statistics) {
+  rclc_executor_handle_statistics_t statistics;
+  rclc_executor_handle_statistics_reset(&statistics);
+  EXPECT_EQ(statistics.invocations, (uint64_t) 0);
+  EXPECT_EQ(statistics.take_failures, (uint64_t) 0);
+  EXPECT_EQ(statistics.callback_time_max_ns, (uint64_t) 0);
+
+  rclc_executor_handle_statistics_record(&statistics, 0);
+  rclc_executor_handle_statistics_record(&statistics, 1);
+  rclc_executor_handle_statistics_record(&statistics, 1000);
+  rclc_executor_handle_statistics_record(&statistics, 1023);
+  rclc_executor_handle_statistics_record(&statistics, UINT64_MAX);
+  EXPECT_EQ(statistics.invocations, (uint64_t) 5);
+  EXPECT_EQ(statistics.callback_time_min_ns, (uint64_t) 0);
+  EXPECT_EQ(statistics.callback_time_max_ns, UINT64_MAX);
+  // durations 0 and 1 ns are counted in bucket 0
+  EXPECT_EQ(statistics.callback_time_histogram[0], (uint64_t) 2);
+  // 1000 and 1023 ns are in [512, 1024)
+  EXPECT_EQ(statistics.callback_time_histogram[9], (uint64_t) 2);
+  // longer durations are counted in the last bucket
+  EXPECT_EQ(
+    statistics.callback_time_histogram[RCLC_EXECUTOR_STATISTICS_HISTOGRAM_SIZE - 1],
+    (uint64_t) 1);
+
+  rclc_executor_handle_statistics_reset(&statistics);
+  EXPECT_EQ(statistics.invocations, (uint64_t) 0);
+  EXPECT_EQ(statistics.callback_time_histogram[9], (uint64_t) 0);
+}
+
 TEST(Test, executor_handle_clear) {
   rcl_ret_t rc;
 
@@ -154,3 +154,86 @@ TEST(Test, rclc_publisher_init_qos) {
   rc = rclc_support_fini(&support);
   EXPECT_EQ(RCL_RET_OK, rc);
 }
+
+TEST(Test, rclc_publisher_loaned_message) {
+  rclc_support_t support;
+  rcl_ret_t rc;
+
+  // preliminary setup
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rc = rclc_support_init(&support, 0, nullptr, &allocator);
+  const char * my_name = "test_pub_loan";
+  const char * my_namespace = "test_namespace";
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rc = rclc_node_init_default(&node, my_name, my_namespace, &support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32);
+  rc = rclc_publisher_init_default(&publisher, &node, type_support, "topic1");
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  std_msgs__msg__Int32 fallback_msg;
+  std_msgs__msg__Int32__init(&fallback_msg);
+  rclc_publisher_loan_t loan;
+
+  // tests with invalid arguments
+  rc = rclc_publisher_loan_init(nullptr, &publisher, type_support, &fallback_msg);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_publisher_loan_init(&loan, nullptr, type_support, &fallback_msg);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_publisher_loan_init(&loan, &publisher, nullptr, &fallback_msg);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+  rc = rclc_publisher_loan_init(&loan, &publisher, type_support, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rc);
+  rcutils_reset_error();
+
+  // test with valid arguments
+  rc = rclc_publisher_loan_init(&loan, &publisher, type_support, &fallback_msg);
+  EXPECT_EQ(RCL_RET_OK, rc);
+
+  // nothing borrowed
+  rc = rclc_publisher_publish_borrowed_message(&loan);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+
+  // borrow, fill in place and publish
+  void * msg = nullptr;
+  rc = rclc_publisher_borrow_message(&loan, &msg);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  ASSERT_NE(msg, nullptr);
+  if (!loan.is_loaned) {
+    EXPECT_EQ(msg, &fallback_msg);
+  }
+  // only one message can be borrowed at a time
+  void * msg2 = nullptr;
+  rc = rclc_publisher_borrow_message(&loan, &msg2);
+  EXPECT_EQ(RCL_RET_ERROR, rc);
+  rcutils_reset_error();
+  reinterpret_cast<std_msgs__msg__Int32 *>(msg)->data = 42;
+  rc = rclc_publisher_publish_borrowed_message(&loan);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(loan.borrowed_msg, nullptr);
+
+  // borrow and return without publishing
+  rc = rclc_publisher_borrow_message(&loan, &msg);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_publisher_return_borrowed_message(&loan);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  EXPECT_EQ(loan.borrowed_msg, nullptr);
+
+  // clean up
+  rc = rclc_publisher_loan_fini(&loan);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  std_msgs__msg__Int32__fini(&fallback_msg);
+  rc = rcl_publisher_fini(&publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, rc);
+  rc = rclc_support_fini(&support);
+  EXPECT_EQ(RCL_RET_OK, rc);
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2026 - for information on the respective copyright owner
+// see the NOTICE file and/or the repository https://github.com/ros2/rclc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Converts a trace file of the rclc Executor (see rclc_executor_dump_trace) into the
+// Chrome trace JSON format, which can be opened with chrome://tracing or Perfetto.
+//
+// usage: rclc_trace_to_json <trace file> [<json file>]
+//
+// The executor events (spin, rcl_wait, take, trigger) are shown in thread 0, the callbacks of
+// a handle in the thread with the handle id plus one. The callbacks of one handle never
+// overlap, also not with a multi-threaded executor.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rclc/executor_trace.h"
+
+static
+void
+print_event(FILE * out, const rclc_executor_trace_event_t * event, int64_t start, int first)
+{
+  // Chrome trace timestamps are in microseconds
+  double ts = (double) (event->timestamp_ns - start) / 1000.0;
+  const char * separator = first ? "" : ",\n";
+
+  switch (event->type) {
+    case RCLC_EXECUTOR_TRACE_SPIN_START:
+      fprintf(
+        out, "%s{\"name\":\"wait\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,\"tid\":0}",
+        separator, ts);
+      break;
+    case RCLC_EXECUTOR_TRACE_WAIT_RETURN:
+      fprintf(
+        out, "%s{\"name\":\"wait\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":0,"
+        "\"args\":{\"rc\":%" PRId64 "}}", separator, ts, event->value);
+      break;
+    case RCLC_EXECUTOR_TRACE_TAKE:
+      fprintf(
+        out, "%s{\"name\":\"take\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":0,"
+        "\"args\":{\"handle\":%" PRIu32 ",\"rc\":%" PRId64 "}}",
+        separator, ts, event->handle_id, event->value);
+      break;
+    case RCLC_EXECUTOR_TRACE_CALLBACK_START:
+      fprintf(
+        out, "%s{\"name\":\"handle %" PRIu32 "\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,"
+        "\"tid\":%" PRIu64 "}",
+        separator, event->handle_id, ts, (uint64_t) event->handle_id + 1);
+      break;
+    case RCLC_EXECUTOR_TRACE_CALLBACK_END:
+      fprintf(
+        out, "%s{\"name\":\"handle %" PRIu32 "\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,"
+        "\"tid\":%" PRIu64 "}",
+        separator, event->handle_id, ts, (uint64_t) event->handle_id + 1);
+      break;
+    case RCLC_EXECUTOR_TRACE_TRIGGER:
+      fprintf(
+        out, "%s{\"name\":\"trigger\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":0,"
+        "\"args\":{\"fulfilled\":%" PRId64 "}}", separator, ts, event->value);
+      break;
+    default:
+      fprintf(
+        out, "%s{\"name\":\"unknown %" PRIu32 "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+        "\"pid\":0,\"tid\":0}", separator, event->type, ts);
+      break;
+  }
+}
+
+int
+main(int argc, char ** argv)
+{
+  if ((argc < 2) || (argc > 3)) {
+    fprintf(stderr, "usage: %s <trace file> [<json file>]\n", argv[0]);
+    return 1;
+  }
+
+  FILE * in = fopen(argv[1], "rb");
+  if (NULL == in) {
+    fprintf(stderr, "Could not open %s\n", argv[1]);
+    return 1;
+  }
+  rclc_executor_trace_file_header_t header;
+  if ((fread(&header, sizeof(header), 1, in) != 1) ||
+    (memcmp(header.magic, RCLC_EXECUTOR_TRACE_MAGIC, sizeof(header.magic)) != 0) ||
+    (header.event_size != sizeof(rclc_executor_trace_event_t)))
+  {
+    fprintf(stderr, "%s is not a trace file of the rclc Executor\n", argv[1]);
+    fclose(in);
+    return 1;
+  }
+
+  FILE * out = stdout;
+  if (argc == 3) {
+    out = fopen(argv[2], "w");
+    if (NULL == out) {
+      fprintf(stderr, "Could not open %s\n", argv[2]);
+      fclose(in);
+      return 1;
+    }
+  }
+
+  fprintf(out, "{\"traceEvents\":[\n");
+  rclc_executor_trace_event_t event;
+  int64_t start = 0;
+  uint64_t count = 0;
+  while ((count < header.event_count) && (fread(&event, sizeof(event), 1, in) == 1)) {
+    if (count == 0) {
+      start = event.timestamp_ns;
+    }
+    print_event(out, &event, start, count == 0);
+    count++;
+  }
+  fprintf(
+    out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":%" PRIu64 "}}\n",
+    header.dropped_count);
+
+  int rc = 0;
+  if (count != header.event_count) {
+    fprintf(stderr, "%s is truncated\n", argv[1]);
+    rc = 1;
+  }
+  fclose(in);
+  if (out != stdout) {
+    fclose(out);
+  }
+  return rc;
+}
@@ -67,6 +67,16 @@ void short_timer_callback(rcl_timer_t * timer, int64_t last_call_time)
   printf("shorttimer %d\n",short_timer_counter++);
 }
 
+void overrun_callback(
+  const void * rcl_handle, uint64_t duration_ns, uint64_t wcet_ns, void * context)
+{
+  RCLC_UNUSED(rcl_handle);
+  RCLC_UNUSED(context);
+  printf(
+    "Overrun: callback took %lu ms (WCET %lu ms)\n",
+    (unsigned long) (duration_ns / 1000000), (unsigned long) (wcet_ns / 1000000));
+}
+
 /******************** MAIN PROGRAM ****************************************/
 int main(int argc, const char * argv[])
 {
@@ -190,6 +200,13 @@ int main(int argc, const char * argv[])
   if (rc != RCL_RET_OK) {
     printf("Error in rclc_executor_add_timer.\n");
   }
+
+  // report the subscription callbacks, which delay the short timer
+  rc = rclc_executor_set_handle_wcet(&executor, &my_sub, RCL_MS_TO_NS(short_timer_timeout));
+  rc += rclc_executor_set_overrun_callback(&executor, &overrun_callback, NULL);
+  if (rc != RCL_RET_OK) {
+    printf("Error in rclc_executor_set_handle_wcet.\n");
+  }
   // Start Executor
   rclc_executor_spin(&executor);
 